@@ -0,0 +1,279 @@
+// Frame-cost benchmark for the aquarium watchface.
+//
+// Steps the simulation for a fixed number of frames from a fixed seed and
+// times animation_update and every draw routine separately, alongside the
+// graphics primitives each one issues, so runs from different commits can be
+// diffed.
+//
+// Usage: bench [--frames N] [--warmup N] [--seed S] [--format csv|json]
+#define main aqua_main
+#include "../src/c/main.c"
+#undef main
+
+#include "pebble_host.h"
+
+#define BENCH_EPOCH 1767225600  // Same starting instant as sim
+
+typedef void (*BenchDrawFn)(GContext *ctx);
+
+typedef struct {
+    const char *name;
+    BenchDrawFn draw;     // NULL for rows measured outside the draw table
+    uint64_t ns;
+    uint64_t calls;       // Routine invocations, summed over all frames
+    HostGfxCounters gfx;  // Primitives issued, summed over all frames
+} BenchRow;
+
+// Each entry draws every instance of one creature type and adds the number
+// of routine invocations it made to s_draw_calls. Creatures with cached
+// sprites or direct framebuffer kernels go through draw_slot, so they're
+// timed on the path the frame loop uses.
+static uint64_t s_draw_calls;
+
+static void bench_draw_fish(GContext *ctx) {
+    for (int id = ENTITY_FISH; id < ENTITY_BUBBLE; id++) {
+        draw_slot(ctx, id);
+    }
+    s_draw_calls += MAX_FISH + MAX_BIG_FISH;
+}
+
+static void bench_draw_seaweed(GContext *ctx) {
+    for (int id = ENTITY_SEAWEED; id < ENTITY_CLAM; id++) {
+        draw_seaweed(ctx, id);
+    }
+    s_draw_calls += MAX_SEAWEED;
+}
+
+static void bench_draw_bubble(GContext *ctx) {
+    for (int id = ENTITY_BUBBLE; id < ENTITY_OCTOPUS; id++) {
+        draw_slot(ctx, id);
+    }
+    s_draw_calls += MAX_BUBBLES;
+}
+
+static void bench_draw_plankton(GContext *ctx) {
+    for (int id = ENTITY_PLANKTON; id < ENTITY_TURTLE; id++) {
+        draw_slot(ctx, id);
+    }
+    s_draw_calls += MAX_PLANKTON;
+}
+
+static void bench_draw_octopus(GContext *ctx) {
+    draw_octopus(ctx);
+    s_draw_calls++;
+}
+
+static void bench_draw_shark(GContext *ctx) {
+    draw_shark(ctx);
+    s_draw_calls++;
+}
+
+static void bench_draw_turtle(GContext *ctx) {
+    for (int id = ENTITY_TURTLE; id < ENTITY_JELLYFISH; id++) {
+        draw_slot(ctx, id);
+    }
+    s_draw_calls += MAX_TURTLES;
+}
+
+static void bench_draw_jellyfish(GContext *ctx) {
+    for (int id = ENTITY_JELLYFISH; id < ENTITY_SEAHORSE; id++) {
+        draw_jellyfish(ctx, id);
+    }
+    s_draw_calls += MAX_JELLYFISH;
+}
+
+static void bench_draw_crab(GContext *ctx) {
+    draw_slot(ctx, ENTITY_CRAB);
+    s_draw_calls++;
+}
+
+static void bench_draw_clam(GContext *ctx) {
+    draw_slot(ctx, ENTITY_CLAM);
+    s_draw_calls++;
+}
+
+static void bench_draw_seahorse(GContext *ctx) {
+    draw_slot(ctx, ENTITY_SEAHORSE);
+    s_draw_calls++;
+}
+
+static void bench_canvas_update_proc(GContext *ctx) {
+    canvas_update_proc(s_canvas_layer, ctx);
+    s_draw_calls++;
+}
+
+enum { ROW_ANIMATION_UPDATE = 0 };
+
+static BenchRow s_rows[] = {
+    { "animation_update", NULL, 0, 0, {0} },
+    { "canvas_update_proc", bench_canvas_update_proc, 0, 0, {0} },
+    { "draw_fish", bench_draw_fish, 0, 0, {0} },
+    { "draw_seaweed", bench_draw_seaweed, 0, 0, {0} },
+    { "draw_bubble", bench_draw_bubble, 0, 0, {0} },
+    { "draw_plankton", bench_draw_plankton, 0, 0, {0} },
+    { "draw_octopus", bench_draw_octopus, 0, 0, {0} },
+    { "draw_shark", bench_draw_shark, 0, 0, {0} },
+    { "draw_turtle", bench_draw_turtle, 0, 0, {0} },
+    { "draw_jellyfish", bench_draw_jellyfish, 0, 0, {0} },
+    { "draw_crab", bench_draw_crab, 0, 0, {0} },
+    { "draw_clam", bench_draw_clam, 0, 0, {0} },
+    { "draw_seahorse", bench_draw_seahorse, 0, 0, {0} },
+};
+#define ROW_COUNT ((int)(sizeof(s_rows) / sizeof(s_rows[0])))
+
+static void add_counters(HostGfxCounters *sum, const HostGfxCounters *frame) {
+    sum->fill_circle += frame->fill_circle;
+    sum->draw_circle += frame->draw_circle;
+    sum->draw_line += frame->draw_line;
+    sum->gpath_filled += frame->gpath_filled;
+    sum->fill_rect += frame->fill_rect;
+    sum->draw_rect += frame->draw_rect;
+    sum->draw_bitmap += frame->draw_bitmap;
+    sum->color_sets += frame->color_sets;
+    sum->stroke_width_sets += frame->stroke_width_sets;
+    sum->redundant_sets += frame->redundant_sets;
+    sum->pixels += frame->pixels;
+}
+
+static void run_frame(bool record) {
+    uint64_t start = host_monotonic_ns();
+    animation_update();
+    uint64_t elapsed = host_monotonic_ns() - start;
+    if (record) {
+        s_rows[ROW_ANIMATION_UPDATE].ns += elapsed;
+        s_rows[ROW_ANIMATION_UPDATE].calls++;
+    }
+
+    for (int r = 0; r < ROW_COUNT; r++) {
+        if (!s_rows[r].draw) continue;
+
+        GContext *ctx = host_graphics_context();
+        s_draw_calls = 0;
+        host_gfx_counters_reset();
+        start = host_monotonic_ns();
+        s_rows[r].draw(ctx);
+        framebuffer_release(ctx);
+        elapsed = host_monotonic_ns() - start;
+        if (record) {
+            s_rows[r].ns += elapsed;
+            s_rows[r].calls += s_draw_calls;
+            add_counters(&s_rows[r].gfx, host_gfx_counters());
+        }
+    }
+}
+
+static const char *platform_name(void) {
+#if defined(PBL_PLATFORM_CHALK)
+    return "chalk";
+#elif defined(PBL_PLATFORM_BASALT)
+    return "basalt";
+#elif defined(PBL_PLATFORM_DIORITE)
+    return "diorite";
+#else
+    return "aplite";
+#endif
+}
+
+// Per-frame averages of the primitive counters, in output column order
+#define GFX_COLUMNS "fill_circle,draw_circle,draw_line,gpath_filled,fill_rect,draw_rect," \
+                    "draw_bitmap,color_sets,stroke_width_sets,redundant_sets,pixels"
+#define GFX_COUNT 11
+
+static void gfx_per_frame(const HostGfxCounters *gfx, long frames, double out[GFX_COUNT]) {
+    const uint64_t values[GFX_COUNT] = {
+        gfx->fill_circle, gfx->draw_circle, gfx->draw_line, gfx->gpath_filled,
+        gfx->fill_rect, gfx->draw_rect, gfx->draw_bitmap, gfx->color_sets,
+        gfx->stroke_width_sets, gfx->redundant_sets, gfx->pixels,
+    };
+    for (int i = 0; i < GFX_COUNT; i++) {
+        out[i] = (double)values[i] / (double)frames;
+    }
+}
+
+static void print_csv(long frames, long seed) {
+    printf("platform,seed,frames,metric,calls,ns_total,ns_per_frame," GFX_COLUMNS "\n");
+    for (int r = 0; r < ROW_COUNT; r++) {
+        double gfx[GFX_COUNT];
+        gfx_per_frame(&s_rows[r].gfx, frames, gfx);
+        printf("%s,%ld,%ld,%s,%llu,%llu,%llu", platform_name(), seed, frames,
+               s_rows[r].name,
+               (unsigned long long)s_rows[r].calls,
+               (unsigned long long)s_rows[r].ns,
+               (unsigned long long)(s_rows[r].ns / (uint64_t)frames));
+        for (int i = 0; i < GFX_COUNT; i++) {
+            printf(",%.1f", gfx[i]);
+        }
+        printf("\n");
+    }
+}
+
+static void print_json(long frames, long seed) {
+    static const char *gfx_names[GFX_COUNT] = {
+        "fill_circle", "draw_circle", "draw_line", "gpath_filled", "fill_rect", "draw_rect",
+        "draw_bitmap", "color_sets", "stroke_width_sets", "redundant_sets", "pixels",
+    };
+
+    printf("{\n  \"platform\": \"%s\",\n  \"seed\": %ld,\n  \"frames\": %ld,\n  \"metrics\": {\n",
+           platform_name(), seed, frames);
+    for (int r = 0; r < ROW_COUNT; r++) {
+        double gfx[GFX_COUNT];
+        gfx_per_frame(&s_rows[r].gfx, frames, gfx);
+        printf("    \"%s\": {\"calls\": %llu, \"ns_total\": %llu, \"ns_per_frame\": %llu, \"per_frame\": {",
+               s_rows[r].name,
+               (unsigned long long)s_rows[r].calls,
+               (unsigned long long)s_rows[r].ns,
+               (unsigned long long)(s_rows[r].ns / (uint64_t)frames));
+        for (int i = 0; i < GFX_COUNT; i++) {
+            printf("%s\"%s\": %.1f", i ? ", " : "", gfx_names[i], gfx[i]);
+        }
+        printf("}}%s\n", r + 1 < ROW_COUNT ? "," : "");
+    }
+    printf("  }\n}\n");
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--frames N] [--warmup N] [--seed S] [--format csv|json]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    long frames = 5000;
+    long warmup = 200;
+    long seed = 1;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            json = strcmp(argv[++i], "json") == 0;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (frames <= 0) frames = 1;
+
+    setenv("TZ", "UTC", 1);
+    host_clock_set(BENCH_EPOCH + seed);
+    init();
+
+    for (long f = 0; f < warmup; f++) {
+        run_frame(false);
+    }
+    for (long f = 0; f < frames; f++) {
+        run_frame(true);
+    }
+
+    if (json) {
+        print_json(frames, seed);
+    } else {
+        print_csv(frames, seed);
+    }
+
+    deinit();
+    return 0;
+}
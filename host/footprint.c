@@ -0,0 +1,135 @@
+// RAM report for the aquarium's creature state and render buffers.
+//
+// Builds main.c for one platform and prints how many bytes its creature
+// state takes next to the layouts it replaced: the original per-species
+// structs of ints, and the struct-of-arrays store before direction, speed,
+// the active flag and bubble size were packed into one byte per entity.
+// All three are sized with the same MAX_* populations, so the numbers follow
+// whatever the platform build configures.
+//
+// A second line lists the renderer's static buffers and a third the heap
+// it allocates: the sprite budget and what the poses actually took, and the
+// background band, measured by starting the app and rendering one frame.
+// Sizes are the host's; the sprite table holds pointers, so it is smaller
+// on the watch.
+//
+// Usage: footprint
+#define main aqua_main
+#include "../src/c/main.c"
+#undef main
+
+#include "pebble_host.h"
+
+#define FOOTPRINT_EPOCH 1767225600  // 2026-01-01 00:00:00 UTC, as sim uses
+
+// The per-species structs the app started out with
+typedef struct { GPoint pos; int direction; int speed; bool active; int size; int grid_cell; } LegacyFish;
+typedef struct { GPoint base; int offset; int speed; } LegacySeaweed;
+typedef struct { GPoint pos; int size; int speed; bool active; } LegacyBubble;
+typedef struct { GPoint pos; int direction; int speed; bool active; } LegacyPlankton;
+typedef struct { GPoint pos; int direction; int tentacle_offset; int speed; } LegacyOctopus;
+typedef struct { GPoint pos; int direction; int animation_offset; int speed; } LegacyTurtle;
+typedef struct { GPoint pos; int tentacle_offset; int pulse_state; int speed; } LegacyJellyfish;
+typedef struct { GPoint pos; int direction; int jaw_state; int speed; bool active; int timer; } LegacyShark;
+typedef struct { GPoint pos; int curve_state; bool active; int timer; } LegacySeahorse;
+typedef struct { GPoint pos; int direction; int claw_state; int speed; } LegacyCrab;
+typedef struct { GPoint pos; int open_state; } LegacyClam;
+
+static size_t legacy_bytes(void) {
+    return sizeof(LegacyFish) * (MAX_FISH + MAX_BIG_FISH) +
+           sizeof(LegacySeaweed) * MAX_SEAWEED +
+           sizeof(LegacyBubble) * MAX_BUBBLES +
+           sizeof(LegacyPlankton) * MAX_PLANKTON +
+           sizeof(LegacyOctopus) +
+           sizeof(LegacyTurtle) * MAX_TURTLES +
+           sizeof(LegacyJellyfish) * MAX_JELLYFISH +
+           sizeof(LegacyShark) + sizeof(LegacySeahorse) +
+           sizeof(LegacyCrab) + sizeof(LegacyClam) +
+           sizeof(int) * GRID_CELL_COUNT * (MAX_FISH + MAX_BIG_FISH + 1);  // Fish grid
+}
+
+// The entity store with a byte each for direction and speed and a bitmap
+// for the active flags
+typedef struct {
+    int16_t x[ENTITY_COUNT];
+    int16_t y[ENTITY_COUNT];
+    int8_t direction[ENTITY_COUNT];
+    int8_t speed[ENTITY_COUNT];
+    uint16_t phase[ENTITY_COUNT];
+    uint8_t active[(ENTITY_COUNT + 7) / 8];
+} UnpackedEntityStore;
+
+static size_t shared_side_bytes(void) {
+    return sizeof(s_jellyfish_pulse) + sizeof(s_shark_timer) +
+           sizeof(s_broadphase_start) + sizeof(s_broadphase_ids);
+}
+
+static size_t unpacked_bytes(void) {
+    return sizeof(UnpackedEntityStore) + sizeof(int8_t) * MAX_BUBBLES + shared_side_bytes();
+}
+
+static size_t packed_bytes(void) {
+    return sizeof(s_entities) + shared_side_bytes();
+}
+
+// Static buffers of the renderer, beyond the creature state
+static size_t render_buffer_bytes(size_t *draw_slots, size_t *row_spans, size_t *batch,
+                                  size_t *tentacles, size_t *sway, size_t *sprite_table) {
+    *draw_slots = sizeof(s_draw_slots) + sizeof(s_damage);
+#if defined(PBL_ROUND)
+    *row_spans = sizeof(s_row_left) + sizeof(s_row_right);
+#else
+    *row_spans = 0;
+#endif
+    *batch = sizeof(s_batch_commands) + sizeof(s_batch_path_points) +
+             sizeof(s_batches) + sizeof(s_batch_next);
+    *tentacles = sizeof(s_tentacle_poses);
+    *sway = sizeof(s_sway_steps) + sizeof(s_sway_step_counts);
+    *sprite_table = sizeof(s_sprites);
+    return *draw_slots + *row_spans + *batch + *tentacles + *sway + *sprite_table;
+}
+
+static size_t bitmap_bytes(const GBitmap *bitmap) {
+    if (!bitmap) return 0;
+    return (size_t)gbitmap_get_bytes_per_row(bitmap) * gbitmap_get_bounds(bitmap).size.h;
+}
+
+static const char *platform_name(void) {
+#if defined(PBL_PLATFORM_CHALK)
+    return "chalk";
+#elif defined(PBL_PLATFORM_BASALT)
+    return "basalt";
+#elif defined(PBL_PLATFORM_DIORITE)
+    return "diorite";
+#else
+    return "aplite";
+#endif
+}
+
+int main(void) {
+    size_t legacy = legacy_bytes();
+    size_t unpacked = unpacked_bytes();
+    size_t packed = packed_bytes();
+    printf("%-8s entities=%d legacy=%zu unpacked=%zu packed=%zu saved_by_packing=%zu saved_total=%zu\n",
+           platform_name(), ENTITY_COUNT, legacy, unpacked, packed,
+           unpacked - packed, legacy - packed);
+    
+    size_t draw_slots, row_spans, batch, tentacles, sway, sprite_table;
+    size_t buffers = render_buffer_bytes(&draw_slots, &row_spans, &batch,
+                                         &tentacles, &sway, &sprite_table);
+    printf("%-8s buffers draw_slots=%zu row_spans=%zu batch=%zu "
+           "tentacles=%zu sway=%zu sprite_table=%zu total=%zu\n",
+           platform_name(), draw_slots, row_spans, batch,
+           tentacles, sway, sprite_table, buffers);
+    
+    // The sprites and the background band are allocated by the first render
+    host_clock_set(FOOTPRINT_EPOCH);
+    init();
+    host_render();
+    size_t background = bitmap_bytes(s_background);
+    printf("%-8s heap sprite_budget=%d sprite_used=%zu background=%zu total=%zu\n",
+           platform_name(), SPRITE_CACHE_BYTES, s_sprite_bytes, background,
+           s_sprite_bytes + background);
+    deinit();
+    return 0;
+}
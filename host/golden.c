@@ -0,0 +1,234 @@
+// Golden-frame regression test for the aquarium renderer.
+//
+// Runs the watchface from fixed seeds for fixed numbers of animation ticks
+// and compares the rendered screen against checked-in PBM images, so that
+// draw-path optimizations can be verified to be pixel-exact. Frames on the
+// way are also compared against a forced full redraw, which catches damage
+// tracking that misses an area. Most cases do that after every frame; some
+// draw many frames incrementally in between, so that damage left behind by
+// one frame has to be repaired by the ones after it.
+//
+// Usage: golden [--update] [--out DIR] GOLDEN_DIR
+//   --update   rewrite the golden images instead of comparing
+//   --out DIR  where to write the actual frame of a failing case
+// One fixed frame rate, so a case's tick count is also its number of
+// simulation steps whatever the governor would have chosen
+#define FRAME_INTERVAL_LADDER 50
+// Cases count animation ticks, so the animation must never go idle
+#define IDLE_TIMEOUT_MS 0
+
+#define main aqua_main
+#include "../src/c/main.c"
+#undef main
+
+#include <errno.h>
+
+#include "pebble_host.h"
+
+#define GOLDEN_EPOCH 1767225600  // Same starting instant as sim
+
+typedef struct {
+    long seed;
+    long ticks;
+    long check_every;   // Frames between full-redraw comparisons; 0 for only the last
+} GoldenCase;
+
+// A spread of seeds and run lengths: the first frame, mid-run scenes with
+// fish eaten and respawned, frames with the shark crossing the screen, the
+// crab walking under the seahorse and a long run, then long stretches of
+// incremental frames
+static const GoldenCase s_cases[] = {
+    { 1, 1, 1 },
+    { 1, 100, 1 },
+    { 1, 210, 1 },
+    { 1, 320, 1 },
+    { 1, 780, 1 },
+    { 2, 250, 1 },
+    { 3, 700, 1 },
+    { 4, 275, 1 },
+    { 4, 1500, 1 },
+    { 2, 900, 40 },
+    { 3, 600, 0 },
+};
+#define CASE_COUNT ((int)(sizeof(s_cases) / sizeof(s_cases[0])))
+
+#define FRAME_WIDTH PBL_DISPLAY_WIDTH
+#define FRAME_HEIGHT PBL_DISPLAY_HEIGHT
+
+// One byte per pixel: 1 for white, 0 for black
+typedef uint8_t Frame[FRAME_HEIGHT][FRAME_WIDTH];
+
+static void capture_frame(Frame frame) {
+    for (int y = 0; y < FRAME_HEIGHT; y++) {
+        for (int x = 0; x < FRAME_WIDTH; x++) {
+            GColor pixel = host_framebuffer_get_pixel(x, y);
+            frame[y][x] = pixel.r + pixel.g + pixel.b > 4;
+        }
+    }
+}
+
+static int count_diff(Frame a, Frame b);
+
+// Checks the incrementally drawn screen against a full redraw of the same
+// state, which the screen then shows
+static bool matches_full_redraw(void) {
+    static Frame incremental, full;
+    capture_frame(incremental);
+    request_full_redraw();
+    host_render();
+    capture_frame(full);
+    return count_diff(incremental, full) == 0;
+}
+
+// Renders the case into frame, the last frame as drawn incrementally. Every
+// check_every frames, and after the last, the screen is also checked
+// against a full redraw; returns the first tick where they differ, or 0.
+static long render_case(const GoldenCase *test, Frame frame) {
+    long mismatch_tick = 0;
+
+    host_clock_set(GOLDEN_EPOCH + test->seed);
+    host_framebuffer_clear(GColorBlack);
+    host_stats_reset();
+
+    init();
+    uint64_t last_renders = 0;
+    long unchecked = 0;
+    while ((long)host_stats()->timer_fires < test->ticks && host_step()) {
+        if (mismatch_tick || host_stats()->renders == last_renders) continue;
+
+        last_renders = host_stats()->renders;
+        if (++unchecked != test->check_every) continue;
+        unchecked = 0;
+        if (!matches_full_redraw()) mismatch_tick = (long)host_stats()->timer_fires;
+        last_renders = host_stats()->renders;
+    }
+
+    capture_frame(frame);
+    if (!mismatch_tick && unchecked && !matches_full_redraw()) mismatch_tick = test->ticks;
+    deinit();
+    return mismatch_tick;
+}
+
+// Plain (P1) PBM keeps the images diffable in review; 1 is black
+static bool write_pbm(const char *path, Frame frame) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "P1\n%d %d\n", FRAME_WIDTH, FRAME_HEIGHT);
+    for (int y = 0; y < FRAME_HEIGHT; y++) {
+        for (int x = 0; x < FRAME_WIDTH; x++) {
+            fputc(frame[y][x] ? '0' : '1', file);
+        }
+        fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
+
+static bool read_pbm(const char *path, Frame frame) {
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+
+    int width = 0, height = 0;
+    bool ok = fscanf(file, "P1 %d %d", &width, &height) == 2 &&
+              width == FRAME_WIDTH && height == FRAME_HEIGHT;
+    for (int i = 0; ok && i < FRAME_WIDTH * FRAME_HEIGHT; i++) {
+        int c;
+        do {
+            c = fgetc(file);
+        } while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+        if (c != '0' && c != '1') {
+            ok = false;
+            break;
+        }
+        frame[i / FRAME_WIDTH][i % FRAME_WIDTH] = c == '0';
+    }
+    fclose(file);
+    return ok;
+}
+
+static int count_diff(Frame a, Frame b) {
+    int diff = 0;
+    for (int y = 0; y < FRAME_HEIGHT; y++) {
+        for (int x = 0; x < FRAME_WIDTH; x++) {
+            diff += a[y][x] != b[y][x];
+        }
+    }
+    return diff;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--update] [--out DIR] GOLDEN_DIR\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    bool update = false;
+    const char *out_dir = NULL;
+    const char *golden_dir = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (!golden_dir && argv[i][0] != '-') {
+            golden_dir = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!golden_dir) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    setenv("TZ", "UTC", 1);
+
+    static Frame actual, expected;
+    int failures = 0;
+    for (int c = 0; c < CASE_COUNT; c++) {
+        const GoldenCase *test = &s_cases[c];
+        char name[64], path[512];
+        snprintf(name, sizeof(name), "seed%ld_tick%ld.pbm", test->seed, test->ticks);
+        snprintf(path, sizeof(path), "%s/%s", golden_dir, name);
+
+        long mismatch_tick = render_case(test, actual);
+        if (mismatch_tick) {
+            printf("FAIL %s: incremental redraw differs from a full redraw at tick %ld\n",
+                   name, mismatch_tick);
+            failures++;
+            continue;
+        }
+
+        if (update) {
+            if (!write_pbm(path, actual)) {
+                fprintf(stderr, "golden: cannot write %s: %s\n", path, strerror(errno));
+                return 1;
+            }
+            printf("updated %s\n", path);
+            continue;
+        }
+
+        if (!read_pbm(path, expected)) {
+            printf("FAIL %s: missing or malformed golden image\n", name);
+            failures++;
+            continue;
+        }
+
+        int diff = count_diff(actual, expected);
+        if (diff == 0) {
+            printf("ok   %s\n", name);
+            continue;
+        }
+
+        printf("FAIL %s: %d pixels differ\n", name, diff);
+        failures++;
+        if (out_dir) {
+            snprintf(path, sizeof(path), "%s/%s", out_dir, name);
+            if (write_pbm(path, actual)) printf("     actual frame written to %s\n", path);
+        }
+    }
+
+    if (!update) printf("%d/%d golden frames match\n", CASE_COUNT - failures, CASE_COUNT);
+    return failures ? 1 : 0;
+}
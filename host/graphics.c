@@ -0,0 +1,566 @@
+// Software rasterizer behind the host graphics shim.
+//
+// Draws into a framebuffer laid out like the watch's: 1 bit per pixel on
+// black and white platforms and 8-bit ARGB on color ones. The shapes follow
+// simple integer rules rather than the firmware's exact algorithms; what
+// matters is that they are deterministic, so golden frames can be compared
+// pixel for pixel.
+#include "host_internal.h"
+
+#if defined(PBL_BW)
+#define FB_ROW_SIZE (((PBL_DISPLAY_WIDTH + 31) / 32) * 4)
+#else
+#define FB_ROW_SIZE PBL_DISPLAY_WIDTH
+#endif
+
+static uint8_t s_framebuffer[FB_ROW_SIZE * PBL_DISPLAY_HEIGHT];
+static bool s_framebuffer_captured;  // Drawing is dropped while the app holds it
+static HostGfxCounters s_gfx;
+
+static const GRect s_screen = {{0, 0}, {PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT}};
+
+// ---------------------------------------------------------------------------
+// Helpers
+
+static int min_int(int a, int b) {
+    return a < b ? a : b;
+}
+
+static int max_int(int a, int b) {
+    return a > b ? a : b;
+}
+
+static int isqrt(int value) {
+    int root = 0;
+    while ((root + 1) * (root + 1) <= value) root++;
+    return root;
+}
+
+// Integer division rounding half away from zero
+static int div_round(int num, int den) {
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    return num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+}
+
+GRect grect_intersect(GRect a, GRect b) {
+    int x0 = max_int(a.origin.x, b.origin.x);
+    int y0 = max_int(a.origin.y, b.origin.y);
+    int x1 = min_int(a.origin.x + a.size.w, b.origin.x + b.size.w);
+    int y1 = min_int(a.origin.y + a.size.h, b.origin.y + b.size.h);
+    if (x1 <= x0 || y1 <= y0) return GRectZero;
+    return GRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+bool gcolor_equal(GColor8 x, GColor8 y) {
+    return x.argb == y.argb;
+}
+
+bool grect_equal(const GRect *const rect_a, const GRect *const rect_b) {
+    return rect_a->origin.x == rect_b->origin.x && rect_a->origin.y == rect_b->origin.y &&
+           rect_a->size.w == rect_b->size.w && rect_a->size.h == rect_b->size.h;
+}
+
+void grect_clip(GRect *const rect_to_clip, const GRect *const rect_clipper) {
+    *rect_to_clip = grect_intersect(*rect_to_clip, *rect_clipper);
+}
+
+GPoint grect_center_point(const GRect *rect) {
+    return GPoint(rect->origin.x + rect->size.w / 2, rect->origin.y + rect->size.h / 2);
+}
+
+// ---------------------------------------------------------------------------
+// Framebuffer
+
+static void fb_write(int x, int y, GColor color) {
+#if defined(PBL_BW)
+    uint8_t *byte = &s_framebuffer[y * FB_ROW_SIZE + x / 8];
+    uint8_t bit = (uint8_t)(1u << (x % 8));
+    if (color.r + color.g + color.b > 4) {
+        *byte |= bit;
+    } else {
+        *byte &= (uint8_t)~bit;
+    }
+#else
+    s_framebuffer[y * FB_ROW_SIZE + x] = color.argb;
+#endif
+}
+
+GColor host_framebuffer_get_pixel(int x, int y) {
+    if (x < 0 || y < 0 || x >= PBL_DISPLAY_WIDTH || y >= PBL_DISPLAY_HEIGHT) return GColorClear;
+#if defined(PBL_BW)
+    bool white = s_framebuffer[y * FB_ROW_SIZE + x / 8] & (1u << (x % 8));
+    return white ? GColorWhite : GColorBlack;
+#else
+    return (GColor8){.argb = s_framebuffer[y * FB_ROW_SIZE + x]};
+#endif
+}
+
+void host_framebuffer_clear(GColor color) {
+    for (int y = 0; y < PBL_DISPLAY_HEIGHT; y++) {
+        for (int x = 0; x < PBL_DISPLAY_WIDTH; x++) {
+            fb_write(x, y, color);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Counters
+
+const HostGfxCounters *host_gfx_counters(void) {
+    return &s_gfx;
+}
+
+void host_gfx_counters_reset(void) {
+    memset(&s_gfx, 0, sizeof(s_gfx));
+}
+
+// ---------------------------------------------------------------------------
+// Pixel and span writers. Coordinates are in screen space and every write
+// is clipped to the layer being drawn.
+
+static void plot(const GContext *ctx, int x, int y, GColor color) {
+    const GRect *clip = &ctx->clip;
+    if (s_framebuffer_captured) return;
+    if (x < clip->origin.x || x >= clip->origin.x + clip->size.w ||
+        y < clip->origin.y || y >= clip->origin.y + clip->size.h) {
+        return;
+    }
+    fb_write(x, y, color);
+    s_gfx.pixels++;
+}
+
+static void hspan(const GContext *ctx, int y, int x0, int x1, GColor color) {
+    const GRect *clip = &ctx->clip;
+    if (s_framebuffer_captured) return;
+    if (y < clip->origin.y || y >= clip->origin.y + clip->size.h) return;
+    x0 = max_int(x0, clip->origin.x);
+    x1 = min_int(x1, clip->origin.x + clip->size.w - 1);
+    for (int x = x0; x <= x1; x++) {
+        fb_write(x, y, color);
+    }
+    if (x1 >= x0) s_gfx.pixels += (uint64_t)(x1 - x0 + 1);
+}
+
+// A square brush of the given width centred on (x, y)
+static void stamp(const GContext *ctx, int x, int y, int width, GColor color) {
+    if (width <= 1) {
+        plot(ctx, x, y, color);
+        return;
+    }
+    int lo = -(width - 1) / 2;
+    for (int dy = lo; dy < lo + width; dy++) {
+        hspan(ctx, y + dy, x + lo, x + lo + width - 1, color);
+    }
+}
+
+static void raster_line(const GContext *ctx, GPoint p0, GPoint p1, int width, GColor color) {
+    int x = p0.x, y = p0.y;
+    int dx = abs(p1.x - p0.x), sx = p0.x < p1.x ? 1 : -1;
+    int dy = -abs(p1.y - p0.y), sy = p0.y < p1.y ? 1 : -1;
+    int err = dx + dy;
+
+    for (;;) {
+        stamp(ctx, x, y, width, color);
+        if (x == p1.x && y == p1.y) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x += sx; }
+        if (e2 <= dx) { err += dx; y += sy; }
+    }
+}
+
+static GPoint to_screen(const GContext *ctx, GPoint p) {
+    return GPoint(p.x + ctx->offset.x, p.y + ctx->offset.y);
+}
+
+static bool is_clear(GColor color) {
+    return color.a == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Context state
+
+void graphics_context_begin_layer(GContext *ctx, GPoint origin, GRect clip) {
+    ctx->fill_color = GColorBlack;
+    ctx->stroke_color = GColorBlack;
+    ctx->stroke_width = 1;
+    ctx->compositing_mode = GCompOpAssign;
+    ctx->offset = origin;
+    ctx->clip = grect_intersect(clip, s_screen);
+}
+
+GContext *host_graphics_context(void) {
+    static GContext s_ctx;
+    graphics_context_begin_layer(&s_ctx, GPointZero, s_screen);
+    return &s_ctx;
+}
+
+static void count_color_set(GColor old_color, GColor new_color) {
+    s_gfx.color_sets++;
+    if (old_color.argb == new_color.argb) s_gfx.redundant_sets++;
+}
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+    count_color_set(ctx->fill_color, color);
+    ctx->fill_color = color;
+}
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+    count_color_set(ctx->stroke_color, color);
+    ctx->stroke_color = color;
+}
+
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t stroke_width) {
+    s_gfx.stroke_width_sets++;
+    if (ctx->stroke_width == stroke_width) s_gfx.redundant_sets++;
+    ctx->stroke_width = stroke_width;
+}
+
+// ---------------------------------------------------------------------------
+// Primitives
+
+// How far row k (counted from the rounded edge) is pulled in by a corner
+static int corner_inset(int radius, int k) {
+    if (k >= radius) return 0;
+    int dy = radius - k;
+    return radius - isqrt(radius * radius - dy * dy);
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+    s_gfx.fill_rect++;
+    if (is_clear(ctx->fill_color) || rect.size.w <= 0 || rect.size.h <= 0) return;
+
+    GPoint origin = to_screen(ctx, rect.origin);
+    int radius = min_int(corner_radius, min_int(rect.size.w, rect.size.h) / 2);
+    if (corner_mask == GCornerNone) radius = 0;
+
+    for (int row = 0; row < rect.size.h; row++) {
+        int top = row;
+        int bottom = rect.size.h - 1 - row;
+        int left = 0, right = 0;
+        if (radius) {
+            if (top < radius) {
+                if (corner_mask & GCornerTopLeft) left = corner_inset(radius, top);
+                if (corner_mask & GCornerTopRight) right = corner_inset(radius, top);
+            }
+            if (bottom < radius) {
+                if (corner_mask & GCornerBottomLeft) left = max_int(left, corner_inset(radius, bottom));
+                if (corner_mask & GCornerBottomRight) right = max_int(right, corner_inset(radius, bottom));
+            }
+        }
+        hspan(ctx, origin.y + row, origin.x + left, origin.x + rect.size.w - 1 - right, ctx->fill_color);
+    }
+}
+
+void graphics_draw_rect(GContext *ctx, GRect rect) {
+    s_gfx.draw_rect++;
+    if (is_clear(ctx->stroke_color) || rect.size.w <= 0 || rect.size.h <= 0) return;
+
+    GPoint origin = to_screen(ctx, rect.origin);
+    int x0 = origin.x, x1 = origin.x + rect.size.w - 1;
+    int y0 = origin.y, y1 = origin.y + rect.size.h - 1;
+    hspan(ctx, y0, x0, x1, ctx->stroke_color);
+    if (y1 != y0) hspan(ctx, y1, x0, x1, ctx->stroke_color);
+    for (int y = y0 + 1; y < y1; y++) {
+        plot(ctx, x0, y, ctx->stroke_color);
+        if (x1 != x0) plot(ctx, x1, y, ctx->stroke_color);
+    }
+}
+
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius) {
+    s_gfx.fill_circle++;
+    if (is_clear(ctx->fill_color)) return;
+
+    p = to_screen(ctx, p);
+    int r = radius;
+    for (int dy = -r; dy <= r; dy++) {
+        int half = isqrt(r * r - dy * dy);
+        hspan(ctx, p.y + dy, p.x - half, p.x + half, ctx->fill_color);
+    }
+}
+
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius) {
+    s_gfx.draw_circle++;
+    if (is_clear(ctx->stroke_color)) return;
+
+    p = to_screen(ctx, p);
+    GColor color = ctx->stroke_color;
+    if (radius == 0) {
+        plot(ctx, p.x, p.y, color);
+        return;
+    }
+
+    // Midpoint circle, one octant mirrored eight ways
+    int x = radius, y = 0, err = 1 - x;
+    while (x >= y) {
+        plot(ctx, p.x + x, p.y + y, color);
+        plot(ctx, p.x - x, p.y + y, color);
+        plot(ctx, p.x + x, p.y - y, color);
+        plot(ctx, p.x - x, p.y - y, color);
+        plot(ctx, p.x + y, p.y + x, color);
+        plot(ctx, p.x - y, p.y + x, color);
+        plot(ctx, p.x + y, p.y - x, color);
+        plot(ctx, p.x - y, p.y - x, color);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+    s_gfx.draw_line++;
+    if (is_clear(ctx->stroke_color)) return;
+
+    raster_line(ctx, to_screen(ctx, p0), to_screen(ctx, p1), ctx->stroke_width, ctx->stroke_color);
+}
+
+// ---------------------------------------------------------------------------
+// Bitmaps
+
+struct GBitmap {
+    uint8_t *data;
+    uint16_t row_size;
+    GSize size;
+    GBitmapFormat format;
+    bool owns_data;    // False for the framebuffer wrapper
+};
+
+static struct GBitmap s_framebuffer_bitmap = {
+    .data = s_framebuffer,
+    .row_size = FB_ROW_SIZE,
+    .size = {PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT},
+    .format = PBL_IF_BW_ELSE(GBitmapFormat1Bit, GBitmapFormat8Bit),
+};
+
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format) {
+    if (size.w <= 0 || size.h <= 0) return NULL;
+    uint16_t row_size = format == GBitmapFormat1Bit ? ((size.w + 31) / 32) * 4 : (uint16_t)size.w;
+
+    GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+    if (!bitmap) return NULL;
+    bitmap->data = calloc(row_size, (size_t)size.h);
+    if (!bitmap->data) {
+        free(bitmap);
+        return NULL;
+    }
+    bitmap->row_size = row_size;
+    bitmap->size = size;
+    bitmap->format = format;
+    bitmap->owns_data = true;
+    return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+    if (!bitmap || !bitmap->owns_data) return;
+    free(bitmap->data);
+    free(bitmap);
+}
+
+uint8_t *gbitmap_get_data(const GBitmap *bitmap) {
+    return bitmap->data;
+}
+
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap) {
+    return bitmap->row_size;
+}
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) {
+    return GRect(0, 0, bitmap->size.w, bitmap->size.h);
+}
+
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap) {
+    return bitmap->format;
+}
+
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y) {
+    return (GBitmapDataRowInfo){
+        .data = bitmap->data + (size_t)y * bitmap->row_size,
+        .min_x = 0,
+        .max_x = (int16_t)(bitmap->size.w - 1),
+    };
+}
+
+static GColor bitmap_pixel(const GBitmap *bitmap, int x, int y) {
+    const uint8_t *row = bitmap->data + (size_t)y * bitmap->row_size;
+    if (bitmap->format == GBitmapFormat1Bit) {
+        return (row[x / 8] & (1u << (x % 8))) ? GColorWhite : GColorBlack;
+    }
+    return (GColor8){.argb = row[x]};
+}
+
+static bool is_white(GColor color) {
+    return color.r + color.g + color.b > 4;
+}
+
+// Combines one source pixel with the framebuffer the way the firmware's
+// compositing modes do. The boolean modes work on black and white.
+static GColor composite(GColor dest, GColor src, GCompOp mode, GBitmapFormat format) {
+    switch (mode) {
+        case GCompOpAssignInverted:
+            return is_white(src) ? GColorBlack : GColorWhite;
+        case GCompOpOr:
+            return is_white(src) || is_white(dest) ? GColorWhite : GColorBlack;
+        case GCompOpAnd:
+            return is_white(src) && is_white(dest) ? GColorWhite : GColorBlack;
+        case GCompOpClear:
+            return is_white(src) ? GColorBlack : dest;
+        case GCompOpSet:
+            if (format == GBitmapFormat1Bit) return is_white(src) ? dest : GColorWhite;
+            if (src.a == 3) return src;
+            if (src.a == 0) return dest;
+            return (GColor8){
+                .a = 3,
+                .r = (uint8_t)((src.r * src.a + dest.r * (3 - src.a)) / 3),
+                .g = (uint8_t)((src.g * src.a + dest.g * (3 - src.a)) / 3),
+                .b = (uint8_t)((src.b * src.a + dest.b * (3 - src.a)) / 3),
+            };
+        case GCompOpAssign:
+        default:
+            src.a = 3;
+            return src;
+    }
+}
+
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) {
+    ctx->compositing_mode = mode;
+}
+
+// Tiles the bitmap over rect, as the firmware does when rect is larger
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {
+    s_gfx.draw_bitmap++;
+    if (!bitmap || s_framebuffer_captured) return;
+
+    GPoint origin = to_screen(ctx, rect.origin);
+    GRect area = grect_intersect(GRect(origin.x, origin.y, rect.size.w, rect.size.h), ctx->clip);
+    s_gfx.pixels += (uint64_t)area.size.w * (uint64_t)area.size.h;
+
+#if defined(PBL_BW)
+    // The firmware blits 1-bit bitmaps a byte at a time; do the same here so
+    // host timings of sprite-heavy frames aren't dominated by the shim
+    bool tiled = rect.size.w > bitmap->size.w || rect.size.h > bitmap->size.h;
+    GCompOp mode = ctx->compositing_mode;
+    if (bitmap->format == GBitmapFormat1Bit && !tiled &&
+        (mode == GCompOpOr || mode == GCompOpClear || mode == GCompOpAssign)) {
+        for (int y = area.origin.y; y < area.origin.y + area.size.h; y++) {
+            const uint8_t *src_row = bitmap->data + (size_t)(y - origin.y) * bitmap->row_size;
+            uint8_t *dest_row = s_framebuffer + (size_t)y * FB_ROW_SIZE;
+            int x = area.origin.x;
+            int end = area.origin.x + area.size.w;
+            while (x < end) {
+                // The source bits that land in this framebuffer byte
+                int count = min_int(8 - x % 8, end - x);
+                int src_x = x - origin.x;
+                unsigned bits = src_row[src_x / 8] >> (src_x % 8);
+                if (src_x % 8 + count > 8) bits |= (unsigned)src_row[src_x / 8 + 1] << (8 - src_x % 8);
+                unsigned span = ((1u << count) - 1) << (x % 8);
+                bits = (bits << (x % 8)) & span;
+
+                uint8_t *dest = &dest_row[x / 8];
+                if (mode == GCompOpOr) {
+                    *dest |= (uint8_t)bits;
+                } else if (mode == GCompOpClear) {
+                    *dest &= (uint8_t)~bits;
+                } else {
+                    *dest = (uint8_t)((*dest & ~span) | bits);
+                }
+                x += count;
+            }
+        }
+        return;
+    }
+#endif
+
+    for (int y = area.origin.y; y < area.origin.y + area.size.h; y++) {
+        int src_y = (y - origin.y) % bitmap->size.h;
+        for (int x = area.origin.x; x < area.origin.x + area.size.w; x++) {
+            GColor src = bitmap_pixel(bitmap, (x - origin.x) % bitmap->size.w, src_y);
+            fb_write(x, y, composite(host_framebuffer_get_pixel(x, y), src,
+                                     ctx->compositing_mode, bitmap->format));
+        }
+    }
+}
+
+GBitmap *graphics_capture_frame_buffer(GContext *ctx) {
+    (void)ctx;
+    if (s_framebuffer_captured) return NULL;
+    s_framebuffer_captured = true;
+    return &s_framebuffer_bitmap;
+}
+
+bool graphics_release_frame_buffer(GContext *ctx, GBitmap *bitmap) {
+    (void)ctx;
+    if (!s_framebuffer_captured || bitmap != &s_framebuffer_bitmap) return false;
+    s_framebuffer_captured = false;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Paths
+
+GPath *gpath_create(const GPathInfo *init) {
+    GPath *path = calloc(1, sizeof(GPath));
+    if (!path) return NULL;
+    path->num_points = init->num_points;
+    path->points = init->points;
+    return path;
+}
+
+void gpath_destroy(GPath *path) {
+    free(path);
+}
+
+void gpath_move_to(GPath *path, GPoint point) {
+    path->offset = point;
+}
+
+// Even-odd scanline fill of the polygon, then its outline so thin slivers
+// still cover the pixels their edges pass through. Rotation isn't modelled.
+void gpath_draw_filled(GContext *ctx, GPath *path) {
+    s_gfx.gpath_filled++;
+    if (is_clear(ctx->fill_color) || path->num_points == 0) return;
+
+    enum { MAX_PATH_POINTS = 16 };
+    uint32_t count = path->num_points < MAX_PATH_POINTS ? path->num_points : MAX_PATH_POINTS;
+    GPoint points[MAX_PATH_POINTS];
+    GPoint offset = to_screen(ctx, path->offset);
+    int min_y = INT16_MAX, max_y = INT16_MIN;
+    for (uint32_t i = 0; i < count; i++) {
+        points[i] = GPoint(path->points[i].x + offset.x, path->points[i].y + offset.y);
+        min_y = min_int(min_y, points[i].y);
+        max_y = max_int(max_y, points[i].y);
+    }
+
+    for (int y = min_y; y <= max_y; y++) {
+        int xs[MAX_PATH_POINTS];
+        int crossings = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            GPoint a = points[i];
+            GPoint b = points[(i + 1) % count];
+            if (a.y == b.y) continue;
+            if ((y < a.y) == (y < b.y)) continue;  // Half-open: [min_y, max_y)
+
+            int x = a.x + div_round((y - a.y) * (b.x - a.x), b.y - a.y);
+
+            // Insertion sort; there are only a handful of crossings per row
+            int k = crossings++;
+            while (k > 0 && xs[k - 1] > x) {
+                xs[k] = xs[k - 1];
+                k--;
+            }
+            xs[k] = x;
+        }
+        for (int k = 0; k + 1 < crossings; k += 2) {
+            hspan(ctx, y, xs[k], xs[k + 1], ctx->fill_color);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        raster_line(ctx, points[i], points[(i + 1) % count], 1, ctx->fill_color);
+    }
+}
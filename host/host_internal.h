@@ -0,0 +1,19 @@
+// Definitions shared between the host shim's translation units.
+#pragma once
+
+#include "pebble_host.h"
+
+struct GContext {
+    GColor fill_color;
+    GColor stroke_color;
+    uint8_t stroke_width;
+    GCompOp compositing_mode;
+    GPoint offset;    // Screen position of the layer being drawn
+    GRect clip;       // Screen-space area the layer may draw into
+};
+
+// Resets ctx to the firmware's default drawing state for a layer whose
+// origin and visible area are given in screen coordinates.
+void graphics_context_begin_layer(GContext *ctx, GPoint origin, GRect clip);
+
+GRect grect_intersect(GRect a, GRect b);
@@ -0,0 +1,344 @@
+// Host-side stand-in for the Pebble SDK header.
+//
+// Only the subset of the SDK that src/c/main.c uses is declared here. The
+// implementations live in pebble_host.c and run against a virtual clock so
+// that simulations are reproducible and independent of wall time.
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Platform selection mirrors the SDK's per-target defines. Default to aplite,
+// the most constrained target, when the build doesn't pick one.
+#if !defined(PBL_PLATFORM_APLITE) && !defined(PBL_PLATFORM_BASALT) && \
+    !defined(PBL_PLATFORM_CHALK) && !defined(PBL_PLATFORM_DIORITE)
+#define PBL_PLATFORM_APLITE
+#endif
+
+#if defined(PBL_PLATFORM_CHALK)
+#define PBL_ROUND
+#define PBL_COLOR
+#define PBL_DISPLAY_WIDTH 180
+#define PBL_DISPLAY_HEIGHT 180
+#elif defined(PBL_PLATFORM_BASALT)
+#define PBL_RECT
+#define PBL_COLOR
+#define PBL_DISPLAY_WIDTH 144
+#define PBL_DISPLAY_HEIGHT 168
+#else
+#define PBL_RECT
+#define PBL_BW
+#define PBL_DISPLAY_WIDTH 144
+#define PBL_DISPLAY_HEIGHT 168
+#endif
+
+#if defined(PBL_ROUND)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_false)
+#else
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_true)
+#endif
+
+#if defined(PBL_COLOR)
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_false)
+#else
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_true)
+#endif
+
+// APIs missing from some firmware are tested with PBL_API_EXISTS(name). Only
+// the ones this app guards are listed; aplite's 3.x firmware lacks them.
+#define PBL_API_EXISTS(api) PBL_API_EXISTS_##api
+#if defined(PBL_PLATFORM_APLITE)
+#define PBL_API_EXISTS_layer_get_unobstructed_bounds 0
+#define PBL_API_EXISTS_unobstructed_area_service_subscribe 0
+#else
+#define PBL_API_EXISTS_layer_get_unobstructed_bounds 1
+#define PBL_API_EXISTS_unobstructed_area_service_subscribe 1
+#endif
+
+#define ARRAY_LENGTH(array) (sizeof((array)) / sizeof((array)[0]))
+
+// Geometry
+typedef struct GPoint {
+    int16_t x;
+    int16_t y;
+} GPoint;
+#define GPoint(x, y) ((GPoint){(x), (y)})
+#define GPointZero GPoint(0, 0)
+
+typedef struct GSize {
+    int16_t w;
+    int16_t h;
+} GSize;
+#define GSize(w, h) ((GSize){(w), (h)})
+
+typedef struct GRect {
+    GPoint origin;
+    GSize size;
+} GRect;
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+#define GRectZero GRect(0, 0, 0, 0)
+
+// Colors use the 8-bit ARGB layout on every host target; black and white
+// displays simply threshold them.
+typedef union GColor8 {
+    uint8_t argb;
+    struct {
+        uint8_t b:2;
+        uint8_t g:2;
+        uint8_t r:2;
+        uint8_t a:2;
+    };
+} GColor8;
+typedef GColor8 GColor;
+
+#define GColorClearARGB8 ((uint8_t)0x00)
+#define GColorBlackARGB8 ((uint8_t)0xC0)
+#define GColorWhiteARGB8 ((uint8_t)0xFF)
+#define GColorClear ((GColor8){.argb = GColorClearARGB8})
+#define GColorBlack ((GColor8){.argb = GColorBlackARGB8})
+#define GColorWhite ((GColor8){.argb = GColorWhiteARGB8})
+
+bool gcolor_equal(GColor8 x, GColor8 y);
+bool grect_equal(const GRect *const rect_a, const GRect *const rect_b);
+void grect_clip(GRect *const rect_to_clip, const GRect *const rect_clipper);
+GPoint grect_center_point(const GRect *rect);
+
+typedef enum {
+    GCornerNone = 0,
+    GCornerTopLeft = 1 << 0,
+    GCornerTopRight = 1 << 1,
+    GCornerBottomLeft = 1 << 2,
+    GCornerBottomRight = 1 << 3,
+    GCornersAll = GCornerTopLeft | GCornerTopRight | GCornerBottomLeft | GCornerBottomRight,
+    GCornersTop = GCornerTopLeft | GCornerTopRight,
+    GCornersBottom = GCornerBottomLeft | GCornerBottomRight,
+    GCornersLeft = GCornerTopLeft | GCornerBottomLeft,
+    GCornersRight = GCornerTopRight | GCornerBottomRight,
+} GCornerMask;
+
+typedef enum {
+    GTextAlignmentLeft,
+    GTextAlignmentCenter,
+    GTextAlignmentRight,
+} GTextAlignment;
+
+typedef const void *GFont;
+#define FONT_KEY_GOTHIC_18 "RESOURCE_ID_GOTHIC_18"
+#define FONT_KEY_GOTHIC_28_BOLD "RESOURCE_ID_GOTHIC_28_BOLD"
+GFont fonts_get_system_font(const char *font_key);
+
+// Graphics
+typedef struct GContext GContext;
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t stroke_width);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_draw_rect(GContext *ctx, GRect rect);
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+
+typedef struct GPathInfo {
+    uint32_t num_points;
+    GPoint *points;
+} GPathInfo;
+
+typedef struct GPath {
+    uint32_t num_points;
+    GPoint *points;
+    int32_t rotation;
+    GPoint offset;
+} GPath;
+
+GPath *gpath_create(const GPathInfo *init);
+void gpath_destroy(GPath *path);
+void gpath_move_to(GPath *path, GPoint point);
+void gpath_draw_filled(GContext *ctx, GPath *path);
+
+// Bitmaps. Only the formats the framebuffers use are modelled: 1-bit rows
+// padded to 32 bits, least significant bit first, 1 for white; and one
+// ARGB byte per pixel.
+typedef enum GBitmapFormat {
+    GBitmapFormat1Bit = 0,
+    GBitmapFormat8Bit,
+} GBitmapFormat;
+
+typedef struct GBitmap GBitmap;
+
+typedef struct GBitmapDataRowInfo {
+    uint8_t *data;    // Start of the row; index it with x directly
+    int16_t min_x;    // First and last pixel of the row that exist
+    int16_t max_x;
+} GBitmapDataRowInfo;
+
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format);
+void gbitmap_destroy(GBitmap *bitmap);
+uint8_t *gbitmap_get_data(const GBitmap *bitmap);
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap);
+GRect gbitmap_get_bounds(const GBitmap *bitmap);
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap);
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y);
+
+typedef enum {
+    GCompOpAssign,
+    GCompOpAssignInverted,
+    GCompOpOr,
+    GCompOpAnd,
+    GCompOpClear,   // Paints black where the source is white
+    GCompOpSet,     // Paints white where a 1-bit source is black; alpha blends 8-bit ones
+} GCompOp;
+
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+
+// Direct framebuffer access. Nothing may be drawn until it is released.
+GBitmap *graphics_capture_frame_buffer(GContext *ctx);
+bool graphics_release_frame_buffer(GContext *ctx, GBitmap *bitmap);
+
+// Trigonometry
+#define TRIG_MAX_ANGLE 0x10000
+#define TRIG_MAX_RATIO 0xffff
+int32_t sin_lookup(int32_t angle);
+int32_t cos_lookup(int32_t angle);
+
+// Layers and windows
+typedef struct Layer Layer;
+typedef struct Window Window;
+typedef struct TextLayer TextLayer;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+Layer *layer_create(GRect frame);
+void layer_destroy(Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+GRect layer_get_frame(const Layer *layer);
+#if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+GRect layer_get_unobstructed_bounds(const Layer *layer);
+#endif
+
+typedef void (*WindowHandler)(Window *window);
+typedef struct WindowHandlers {
+    WindowHandler load;
+    WindowHandler appear;
+    WindowHandler disappear;
+    WindowHandler unload;
+} WindowHandlers;
+
+Window *window_create(void);
+void window_destroy(Window *window);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_set_background_color(Window *window, GColor background_color);
+Layer *window_get_root_layer(const Window *window);
+void window_stack_push(Window *window, bool animated);
+
+TextLayer *text_layer_create(GRect frame);
+void text_layer_destroy(TextLayer *text_layer);
+Layer *text_layer_get_layer(TextLayer *text_layer);
+void text_layer_set_text(TextLayer *text_layer, const char *text);
+void text_layer_set_text_color(TextLayer *text_layer, GColor color);
+void text_layer_set_background_color(TextLayer *text_layer, GColor color);
+void text_layer_set_font(TextLayer *text_layer, GFont font);
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment text_alignment);
+
+// Timers
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data);
+void app_timer_cancel(AppTimer *timer_handle);
+
+// Event services
+typedef enum {
+    SECOND_UNIT = 1 << 0,
+    MINUTE_UNIT = 1 << 1,
+    HOUR_UNIT = 1 << 2,
+    DAY_UNIT = 1 << 3,
+    MONTH_UNIT = 1 << 4,
+    YEAR_UNIT = 1 << 5,
+} TimeUnits;
+typedef void (*TickHandler)(struct tm *tick_time, TimeUnits units_changed);
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler);
+void tick_timer_service_unsubscribe(void);
+
+typedef struct BatteryChargeState {
+    uint8_t charge_percent;
+    bool is_charging;
+    bool is_plugged;
+} BatteryChargeState;
+typedef void (*BatteryStateHandler)(BatteryChargeState charge);
+BatteryChargeState battery_state_service_peek(void);
+void battery_state_service_subscribe(BatteryStateHandler handler);
+void battery_state_service_unsubscribe(void);
+
+typedef enum {
+    ACCEL_AXIS_X = 0,
+    ACCEL_AXIS_Y = 1,
+    ACCEL_AXIS_Z = 2,
+} AccelAxisType;
+typedef void (*AccelTapHandler)(AccelAxisType axis, int32_t direction);
+void accel_tap_service_subscribe(AccelTapHandler handler);
+void accel_tap_service_unsubscribe(void);
+
+typedef void (*AppFocusHandler)(bool in_focus);
+void app_focus_service_subscribe(AppFocusHandler handler);
+void app_focus_service_unsubscribe(void);
+
+// Part of the screen not covered by system UI such as a Timeline Quick View
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+typedef int32_t AnimationProgress;
+#define ANIMATION_NORMALIZED_MAX 65535
+typedef void (*UnobstructedAreaWillChangeHandler)(GRect final_unobstructed_screen_area, void *context);
+typedef void (*UnobstructedAreaChangeHandler)(AnimationProgress progress, void *context);
+typedef void (*UnobstructedAreaDidChangeHandler)(void *context);
+typedef struct UnobstructedAreaHandlers {
+    UnobstructedAreaWillChangeHandler will_change;
+    UnobstructedAreaChangeHandler change;
+    UnobstructedAreaDidChangeHandler did_change;
+} UnobstructedAreaHandlers;
+void unobstructed_area_service_subscribe(UnobstructedAreaHandlers handlers, void *context);
+void unobstructed_area_service_unsubscribe(void);
+#endif
+
+// Persistent storage
+typedef enum {
+    S_SUCCESS = 0,
+    E_ERROR = -1,
+    E_INVALID_ARGUMENT = -4,
+    E_OUT_OF_STORAGE = -6,
+    E_DOES_NOT_EXIST = -9,
+} StatusCode;
+typedef int32_t status_t;
+bool persist_exists(const uint32_t key);
+int32_t persist_read_int(const uint32_t key);
+status_t persist_write_int(const uint32_t key, const int32_t value);
+status_t persist_delete(const uint32_t key);
+
+// Wall clock. Both calls read the simulator's virtual clock instead of the
+// host's, so every run with the same settings sees the same time.
+time_t host_time(time_t *tloc);
+#define time(tloc) host_time(tloc)
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+
+// Logging
+typedef enum {
+    APP_LOG_LEVEL_ERROR = 1,
+    APP_LOG_LEVEL_WARNING = 50,
+    APP_LOG_LEVEL_INFO = 100,
+    APP_LOG_LEVEL_DEBUG = 200,
+    APP_LOG_LEVEL_DEBUG_VERBOSE = 255,
+} AppLogLevel;
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...);
+#define APP_LOG(level, fmt, ...) app_log(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+
+void app_event_loop(void);
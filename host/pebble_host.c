@@ -0,0 +1,628 @@
+// Host implementation of the pebble.h shim.
+//
+// Windows, layers, timers and services are modelled closely enough for the
+// watchface to run unchanged. Drawing lives in graphics.c.
+#include <math.h>
+#include <stdarg.h>
+
+#include "host_internal.h"
+
+#define MAX_TIMERS 16
+#define MAX_WINDOWS 4
+#define MAX_PERSIST_KEYS 32
+
+struct Layer {
+    GRect frame;
+    GRect bounds;
+    LayerUpdateProc update_proc;
+    Layer *parent;
+    Layer *first_child;
+    Layer *next_sibling;
+    bool embedded;    // Owned by a Window or TextLayer rather than malloc'd alone
+};
+
+struct Window {
+    Layer root;
+    WindowHandlers handlers;
+    GColor background_color;
+    bool loaded;
+};
+
+struct TextLayer {
+    Layer layer;
+    const char *text;
+    GColor text_color;
+    GColor background_color;
+    GFont font;
+    GTextAlignment alignment;
+};
+
+struct AppTimer {
+    bool used;
+    uint64_t deadline_ms;
+    uint64_t seq;     // Keeps timers with equal deadlines in FIFO order
+    AppTimerCallback callback;
+    void *data;
+};
+
+// Virtual clock in milliseconds since the epoch
+static uint64_t s_now_ms;
+
+static AppTimer s_timers[MAX_TIMERS];
+static uint64_t s_timer_seq;
+
+static Window *s_window_stack[MAX_WINDOWS];
+static int s_window_count;
+static bool s_render_pending;
+
+static TickHandler s_tick_handler;
+static TimeUnits s_tick_units;
+static uint64_t s_next_tick_ms;
+
+static BatteryStateHandler s_battery_handler;
+static BatteryChargeState s_battery_state = {.charge_percent = 100};
+
+// Persistent storage lives as long as the process, so it carries across
+// init/deinit like the watch's does across app launches
+typedef struct {
+    bool used;
+    uint32_t key;
+    int32_t value;
+} PersistEntry;
+
+static PersistEntry s_persist[MAX_PERSIST_KEYS];
+
+static AppFocusHandler s_focus_handler;
+
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+static UnobstructedAreaHandlers s_unobstructed_handlers;
+static void *s_unobstructed_context;
+static GRect s_unobstructed_area = {{0, 0}, {PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT}};
+#endif
+
+static AccelTapHandler s_tap_handler;
+static bool s_tap_pending;
+static uint64_t s_tap_ms;
+static AccelAxisType s_tap_axis;
+static int32_t s_tap_direction;
+
+static AppLogLevel s_log_level = APP_LOG_LEVEL_WARNING;
+static HostStats s_stats;
+
+// ---------------------------------------------------------------------------
+// Clock and statistics
+
+uint64_t host_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t next_tick_after(uint64_t now_ms) {
+    uint64_t unit_ms = (s_tick_units & SECOND_UNIT) ? 1000 : 60000;
+    return (now_ms / unit_ms + 1) * unit_ms;
+}
+
+void host_clock_set(time_t epoch_seconds) {
+    s_now_ms = (uint64_t)epoch_seconds * 1000;
+    s_next_tick_ms = next_tick_after(s_now_ms);
+}
+
+uint64_t host_clock_now_ms(void) {
+    return s_now_ms;
+}
+
+time_t host_time(time_t *tloc) {
+    time_t now = (time_t)(s_now_ms / 1000);
+    if (tloc) *tloc = now;
+    return now;
+}
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms) {
+    uint16_t ms = (uint16_t)(s_now_ms % 1000);
+    host_time(tloc);
+    if (out_ms) *out_ms = ms;
+    return ms;
+}
+
+const HostStats *host_stats(void) {
+    return &s_stats;
+}
+
+void host_stats_reset(void) {
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void host_set_log_level(AppLogLevel level) {
+    s_log_level = level;
+}
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...) {
+    if (log_level > s_log_level) return;
+
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "[%s:%d] ", src_filename, src_line_number);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+// ---------------------------------------------------------------------------
+// Trigonometry
+//
+// The firmware uses a lookup table, so the shim does too: a quarter wave is
+// built once and lookups never touch libm on the hot path.
+
+#define QUARTER_ANGLE (TRIG_MAX_ANGLE / 4)
+static int32_t s_sin_quarter[QUARTER_ANGLE + 1];
+static bool s_sin_ready;
+
+static void build_sin_table(void) {
+    for (int i = 0; i <= QUARTER_ANGLE; i++) {
+        double radians = (double)i * M_PI / (2.0 * QUARTER_ANGLE);
+        s_sin_quarter[i] = (int32_t)lround(sin(radians) * TRIG_MAX_RATIO);
+    }
+    s_sin_ready = true;
+}
+
+int32_t sin_lookup(int32_t angle) {
+    if (!s_sin_ready) build_sin_table();
+
+    uint32_t a = (uint32_t)angle & (TRIG_MAX_ANGLE - 1);
+    if (a < QUARTER_ANGLE) return s_sin_quarter[a];
+    if (a < 2 * QUARTER_ANGLE) return s_sin_quarter[2 * QUARTER_ANGLE - a];
+    if (a < 3 * QUARTER_ANGLE) return -s_sin_quarter[a - 2 * QUARTER_ANGLE];
+    return -s_sin_quarter[TRIG_MAX_ANGLE - a];
+}
+
+int32_t cos_lookup(int32_t angle) {
+    return sin_lookup(angle + QUARTER_ANGLE);
+}
+
+// ---------------------------------------------------------------------------
+// Fonts
+
+GFont fonts_get_system_font(const char *font_key) {
+    return font_key;
+}
+
+// ---------------------------------------------------------------------------
+// Layers
+
+static void layer_init(Layer *layer, GRect frame, bool embedded) {
+    memset(layer, 0, sizeof(*layer));
+    layer->frame = frame;
+    layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+    layer->embedded = embedded;
+}
+
+static void layer_remove_from_parent(Layer *layer) {
+    Layer *parent = layer->parent;
+    if (!parent) return;
+
+    Layer **link = &parent->first_child;
+    while (*link && *link != layer) {
+        link = &(*link)->next_sibling;
+    }
+    if (*link) *link = layer->next_sibling;
+    layer->parent = NULL;
+    layer->next_sibling = NULL;
+}
+
+static void layer_orphan_children(Layer *layer) {
+    Layer *child = layer->first_child;
+    while (child) {
+        Layer *next = child->next_sibling;
+        child->parent = NULL;
+        child->next_sibling = NULL;
+        child = next;
+    }
+    layer->first_child = NULL;
+}
+
+Layer *layer_create(GRect frame) {
+    Layer *layer = malloc(sizeof(Layer));
+    if (!layer) return NULL;
+    layer_init(layer, frame, false);
+    return layer;
+}
+
+void layer_destroy(Layer *layer) {
+    if (!layer) return;
+    layer_remove_from_parent(layer);
+    layer_orphan_children(layer);
+    if (!layer->embedded) free(layer);
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+    layer->update_proc = update_proc;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+    layer_remove_from_parent(child);
+    child->parent = parent;
+
+    Layer **link = &parent->first_child;
+    while (*link) {
+        link = &(*link)->next_sibling;
+    }
+    *link = child;
+}
+
+void layer_mark_dirty(Layer *layer) {
+    (void)layer;
+    s_render_pending = true;
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+    return layer->bounds;
+}
+
+GRect layer_get_frame(const Layer *layer) {
+    return layer->frame;
+}
+
+#if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+GRect layer_get_unobstructed_bounds(const Layer *layer) {
+    GPoint origin = GPointZero;
+    for (const Layer *l = layer; l; l = l->parent) {
+        origin.x += l->frame.origin.x;
+        origin.y += l->frame.origin.y;
+    }
+
+    GRect area = s_unobstructed_area;
+    area.origin.x -= origin.x;
+    area.origin.y -= origin.y;
+    return grect_intersect(layer->bounds, area);
+}
+#endif
+
+static void render_layer(Layer *layer, GContext *ctx, GPoint origin, GRect parent_clip) {
+    GPoint layer_origin = GPoint(origin.x + layer->frame.origin.x,
+                                 origin.y + layer->frame.origin.y);
+    GRect clip = grect_intersect(parent_clip, (GRect){layer_origin, layer->frame.size});
+
+    if (layer->update_proc) {
+        graphics_context_begin_layer(ctx, layer_origin, clip);
+        layer->update_proc(layer, ctx);
+    }
+
+    for (Layer *child = layer->first_child; child; child = child->next_sibling) {
+        render_layer(child, ctx, layer_origin, clip);
+    }
+}
+
+void host_render(void) {
+    if (!s_render_pending || s_window_count == 0) return;
+    s_render_pending = false;
+
+    GContext *ctx = host_graphics_context();
+
+    uint64_t start = host_monotonic_ns();
+    render_layer(&s_window_stack[s_window_count - 1]->root, ctx, GPointZero,
+                 GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT));
+    s_stats.render_ns += host_monotonic_ns() - start;
+    s_stats.renders++;
+}
+
+// ---------------------------------------------------------------------------
+// Windows
+
+static void window_root_update_proc(Layer *layer, GContext *ctx) {
+    Window *window = (Window *)layer;
+    if (window->background_color.argb == GColorClearARGB8) return;
+
+    graphics_context_set_fill_color(ctx, window->background_color);
+    graphics_fill_rect(ctx, layer->bounds, 0, GCornerNone);
+}
+
+Window *window_create(void) {
+    Window *window = calloc(1, sizeof(Window));
+    if (!window) return NULL;
+    layer_init(&window->root, GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT), true);
+    layer_set_update_proc(&window->root, window_root_update_proc);
+    window->background_color = GColorWhite;
+    return window;
+}
+
+void window_destroy(Window *window) {
+    if (!window) return;
+
+    for (int i = 0; i < s_window_count; i++) {
+        if (s_window_stack[i] != window) continue;
+
+        memmove(&s_window_stack[i], &s_window_stack[i + 1],
+                (size_t)(s_window_count - i - 1) * sizeof(Window *));
+        s_window_count--;
+        if (window->handlers.disappear) window->handlers.disappear(window);
+        if (window->loaded && window->handlers.unload) window->handlers.unload(window);
+        break;
+    }
+
+    layer_orphan_children(&window->root);
+    free(window);
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+    window->handlers = handlers;
+}
+
+void window_set_background_color(Window *window, GColor background_color) {
+    window->background_color = background_color;
+}
+
+Layer *window_get_root_layer(const Window *window) {
+    return (Layer *)&window->root;
+}
+
+void window_stack_push(Window *window, bool animated) {
+    (void)animated;
+    if (s_window_count >= MAX_WINDOWS) return;
+
+    s_window_stack[s_window_count++] = window;
+    if (!window->loaded) {
+        window->loaded = true;
+        if (window->handlers.load) window->handlers.load(window);
+    }
+    if (window->handlers.appear) window->handlers.appear(window);
+    s_render_pending = true;
+}
+
+// ---------------------------------------------------------------------------
+// Text layers
+//
+// Text is laid out by the firmware's font engine, which the host doesn't
+// have; text layers keep their state but draw nothing.
+
+TextLayer *text_layer_create(GRect frame) {
+    TextLayer *text_layer = calloc(1, sizeof(TextLayer));
+    if (!text_layer) return NULL;
+    layer_init(&text_layer->layer, frame, true);
+    text_layer->text_color = GColorBlack;
+    text_layer->background_color = GColorWhite;
+    return text_layer;
+}
+
+void text_layer_destroy(TextLayer *text_layer) {
+    if (!text_layer) return;
+    layer_destroy(&text_layer->layer);
+    free(text_layer);
+}
+
+Layer *text_layer_get_layer(TextLayer *text_layer) {
+    return &text_layer->layer;
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+    text_layer->text = text;
+    s_render_pending = true;
+}
+
+void text_layer_set_text_color(TextLayer *text_layer, GColor color) {
+    text_layer->text_color = color;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+    text_layer->background_color = color;
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+    text_layer->font = font;
+}
+
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment text_alignment) {
+    text_layer->alignment = text_alignment;
+}
+
+// ---------------------------------------------------------------------------
+// Timers
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data) {
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        AppTimer *timer = &s_timers[i];
+        if (timer->used) continue;
+
+        timer->used = true;
+        timer->deadline_ms = s_now_ms + timeout_ms;
+        timer->seq = s_timer_seq++;
+        timer->callback = callback;
+        timer->data = callback_data;
+        return timer;
+    }
+    return NULL;
+}
+
+void app_timer_cancel(AppTimer *timer_handle) {
+    if (timer_handle) timer_handle->used = false;
+}
+
+static AppTimer *next_timer(void) {
+    AppTimer *next = NULL;
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        AppTimer *timer = &s_timers[i];
+        if (!timer->used) continue;
+        if (!next || timer->deadline_ms < next->deadline_ms ||
+            (timer->deadline_ms == next->deadline_ms && timer->seq < next->seq)) {
+            next = timer;
+        }
+    }
+    return next;
+}
+
+// ---------------------------------------------------------------------------
+// Services
+
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) {
+    s_tick_units = tick_units;
+    s_tick_handler = handler;
+    s_next_tick_ms = next_tick_after(s_now_ms);
+}
+
+void tick_timer_service_unsubscribe(void) {
+    s_tick_handler = NULL;
+}
+
+BatteryChargeState battery_state_service_peek(void) {
+    return s_battery_state;
+}
+
+void battery_state_service_subscribe(BatteryStateHandler handler) {
+    s_battery_handler = handler;
+}
+
+void battery_state_service_unsubscribe(void) {
+    s_battery_handler = NULL;
+}
+
+void host_set_battery(uint8_t charge_percent, bool is_charging) {
+    s_battery_state.charge_percent = charge_percent;
+    s_battery_state.is_charging = is_charging;
+    s_battery_state.is_plugged = is_charging;
+    if (s_battery_handler) s_battery_handler(s_battery_state);
+}
+
+void app_focus_service_subscribe(AppFocusHandler handler) {
+    s_focus_handler = handler;
+}
+
+void app_focus_service_unsubscribe(void) {
+    s_focus_handler = NULL;
+}
+
+void host_set_app_focus(bool in_focus) {
+    if (s_focus_handler) s_focus_handler(in_focus);
+}
+
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+void unobstructed_area_service_subscribe(UnobstructedAreaHandlers handlers, void *context) {
+    s_unobstructed_handlers = handlers;
+    s_unobstructed_context = context;
+}
+
+void unobstructed_area_service_unsubscribe(void) {
+    s_unobstructed_handlers = (UnobstructedAreaHandlers){0};
+}
+#endif
+
+// Firmware without the service never reports an obstruction to the app
+void host_set_unobstructed_area(GRect area) {
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    UnobstructedAreaHandlers *handlers = &s_unobstructed_handlers;
+    if (handlers->will_change) handlers->will_change(area, s_unobstructed_context);
+    s_unobstructed_area = area;
+    if (handlers->change) handlers->change(ANIMATION_NORMALIZED_MAX, s_unobstructed_context);
+    if (handlers->did_change) handlers->did_change(s_unobstructed_context);
+#else
+    (void)area;
+#endif
+}
+
+void accel_tap_service_subscribe(AccelTapHandler handler) {
+    s_tap_handler = handler;
+}
+
+void accel_tap_service_unsubscribe(void) {
+    s_tap_handler = NULL;
+}
+
+void host_schedule_tap(uint64_t at_ms, AccelAxisType axis, int32_t direction) {
+    s_tap_pending = true;
+    s_tap_ms = at_ms > s_now_ms ? at_ms : s_now_ms;
+    s_tap_axis = axis;
+    s_tap_direction = direction;
+}
+
+bool host_tap_pending(void) {
+    return s_tap_pending;
+}
+
+// ---------------------------------------------------------------------------
+// Persistent storage
+
+static PersistEntry *persist_find(uint32_t key) {
+    for (int i = 0; i < MAX_PERSIST_KEYS; i++) {
+        if (s_persist[i].used && s_persist[i].key == key) return &s_persist[i];
+    }
+    return NULL;
+}
+
+bool persist_exists(const uint32_t key) {
+    return persist_find(key) != NULL;
+}
+
+int32_t persist_read_int(const uint32_t key) {
+    PersistEntry *entry = persist_find(key);
+    return entry ? entry->value : 0;
+}
+
+status_t persist_write_int(const uint32_t key, const int32_t value) {
+    PersistEntry *entry = persist_find(key);
+    for (int i = 0; !entry && i < MAX_PERSIST_KEYS; i++) {
+        if (!s_persist[i].used) entry = &s_persist[i];
+    }
+    if (!entry) return E_OUT_OF_STORAGE;
+
+    entry->used = true;
+    entry->key = key;
+    entry->value = value;
+    return sizeof(value);
+}
+
+status_t persist_delete(const uint32_t key) {
+    PersistEntry *entry = persist_find(key);
+    if (!entry) return E_DOES_NOT_EXIST;
+    entry->used = false;
+    return S_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// Event loop
+
+bool host_step(void) {
+    AppTimer *timer = next_timer();
+    uint64_t timer_ms = timer ? timer->deadline_ms : UINT64_MAX;
+    bool tick_due = s_tick_handler && s_next_tick_ms < timer_ms &&
+                    (!s_tap_pending || s_next_tick_ms <= s_tap_ms);
+    bool tap_due = !tick_due && s_tap_pending && s_tap_ms < timer_ms;
+
+    if (tap_due) {
+        s_now_ms = s_tap_ms;
+        s_tap_pending = false;
+        s_stats.tap_events++;
+        if (s_tap_handler) s_tap_handler(s_tap_axis, s_tap_direction);
+    } else if (tick_due) {
+        s_now_ms = s_next_tick_ms;
+        s_next_tick_ms = next_tick_after(s_now_ms);
+
+        time_t now = (time_t)(s_now_ms / 1000);
+        struct tm *tick_time = localtime(&now);
+        TimeUnits changed = SECOND_UNIT;
+        if (s_now_ms % 60000 == 0) changed |= MINUTE_UNIT;
+        if (s_now_ms % 3600000 == 0) changed |= HOUR_UNIT;
+        s_stats.tick_events++;
+        s_tick_handler(tick_time, changed);
+    } else if (timer) {
+        s_now_ms = timer->deadline_ms;
+
+        // The handle is invalid once its callback runs, as on the watch
+        AppTimerCallback callback = timer->callback;
+        void *data = timer->data;
+        timer->used = false;
+
+        uint64_t start = host_monotonic_ns();
+        callback(data);
+        s_stats.timer_ns += host_monotonic_ns() - start;
+        s_stats.timer_fires++;
+    } else {
+        return false;
+    }
+
+    host_render();
+    return true;
+}
+
+void app_event_loop(void) {
+    while (s_window_count > 0 && host_step()) {
+    }
+}
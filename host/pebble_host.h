@@ -0,0 +1,84 @@
+// Controls for the host-side Pebble simulator.
+//
+// Drivers use these to steer the virtual clock and the event loop that the
+// pebble.h shim implements. Nothing in here exists on the watch.
+#pragma once
+
+#include <pebble.h>
+
+// Virtual clock. The wall clock seen through time() and time_ms() starts at
+// the given epoch and only moves when the event loop advances it.
+void host_clock_set(time_t epoch_seconds);
+uint64_t host_clock_now_ms(void);
+
+// Dispatches the next pending event (an app timer or a tick service
+// callback), advancing the virtual clock to its deadline, then renders the
+// top window if any layer was marked dirty. Returns false when nothing is
+// scheduled.
+bool host_step(void);
+
+// Renders the top window immediately if any layer is dirty.
+void host_render(void);
+
+// Returns the screen's graphics context with its drawing state reset, for
+// drivers that call draw routines directly instead of through a layer.
+GContext *host_graphics_context(void);
+
+// Reads back one pixel of the rendered screen. Off-screen reads return
+// GColorClear; black and white platforms only ever return black or white.
+GColor host_framebuffer_get_pixel(int x, int y);
+void host_framebuffer_clear(GColor color);
+
+// Feeds a new battery state to the app as the battery service would.
+void host_set_battery(uint8_t charge_percent, bool is_charging);
+
+// Schedules an accelerometer tap (a wrist flick, on the watch) at an
+// absolute virtual time. host_step delivers it like any other event. Only
+// one tap is pending at a time; scheduling another replaces it.
+void host_schedule_tap(uint64_t at_ms, AccelAxisType axis, int32_t direction);
+bool host_tap_pending(void);
+
+// Gives or takes away focus, as a notification or modal window would.
+void host_set_app_focus(bool in_focus);
+
+// Covers the screen outside area with system UI (a Timeline Quick View
+// on the watch), running the unobstructed area handlers around the change.
+void host_set_unobstructed_area(GRect area);
+
+// Only messages at or above this level are printed (default: warnings).
+void host_set_log_level(AppLogLevel level);
+
+// Host monotonic time in nanoseconds, for measuring real CPU cost.
+uint64_t host_monotonic_ns(void);
+
+// Graphics primitive counters, accumulated since the last reset. Every
+// draw call through the shim is counted, whether it comes from a layer
+// render or from a driver calling draw routines directly.
+typedef struct {
+    uint64_t fill_circle;
+    uint64_t draw_circle;
+    uint64_t draw_line;
+    uint64_t gpath_filled;
+    uint64_t fill_rect;
+    uint64_t draw_rect;
+    uint64_t draw_bitmap;
+    uint64_t color_sets;          // Fill and stroke color changes
+    uint64_t stroke_width_sets;
+    uint64_t redundant_sets;      // State changes that set the current value
+    uint64_t pixels;              // Pixels written to the framebuffer, overdraw included
+} HostGfxCounters;
+
+const HostGfxCounters *host_gfx_counters(void);
+void host_gfx_counters_reset(void);
+
+typedef struct {
+    uint64_t timer_fires;   // App timer callbacks dispatched
+    uint64_t tick_events;   // Tick service callbacks dispatched
+    uint64_t tap_events;    // Accelerometer taps delivered
+    uint64_t renders;       // Window renders (one per dirty event)
+    uint64_t timer_ns;      // Host time spent inside timer callbacks
+    uint64_t render_ns;     // Host time spent inside layer update procs
+} HostStats;
+
+const HostStats *host_stats(void);
+void host_stats_reset(void);
@@ -0,0 +1,162 @@
+// Headless driver for the aquarium watchface.
+//
+// Builds main.c against the host pebble.h shim, then runs the app's own timer
+// and render loop for a fixed number of animation ticks on the virtual clock
+// and reports CPU time and the graphics primitives issued per frame.
+// With --tap-every the watch is tapped on that period, so idle mode can be
+// exercised; without it a continuous-mode run ends when the app goes idle.
+// --burst stores burst mode with the given burst length in the app's
+// settings before it starts, as a settings page would. --obstruct covers
+// the bottom rows of the screen the way a Timeline Quick View does.
+//
+// Usage: sim [--ticks N] [--seed S] [--battery PCT] [--tap-every SECONDS]
+//            [--burst SECONDS] [--obstruct ROWS] [--verbose]
+#define main aqua_main
+#include "../src/c/main.c"
+#undef main
+
+#include "pebble_host.h"
+
+// All runs start from the same wall-clock instant; the seed shifts it so the
+// app's time-based random seed changes with it.
+#define SIM_EPOCH 1767225600  // 2026-01-01 00:00:00 UTC
+
+static uint64_t count_primitives(const HostGfxCounters *gfx) {
+    return gfx->fill_circle + gfx->draw_circle + gfx->draw_line +
+           gfx->gpath_filled + gfx->fill_rect + gfx->draw_rect + gfx->draw_bitmap;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--ticks N] [--seed S] [--battery PCT] [--tap-every SECONDS] "
+            "[--burst SECONDS] [--obstruct ROWS] [--verbose]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    long ticks = 1000;
+    long seed = 1;
+    int battery = 100;
+    long tap_every_s = 0;
+    long burst_s = 0;
+    int obstruct_rows = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            battery = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--tap-every") == 0 && i + 1 < argc) {
+            tap_every_s = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--burst") == 0 && i + 1 < argc) {
+            burst_s = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--obstruct") == 0 && i + 1 < argc) {
+            obstruct_rows = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            host_set_log_level(APP_LOG_LEVEL_DEBUG);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    setenv("TZ", "UTC", 1);
+    host_clock_set(SIM_EPOCH + seed);
+    host_set_battery((uint8_t)battery, false);
+    if (burst_s > 0) {
+        persist_write_int(PERSIST_KEY_ANIMATION_MODE, ANIMATION_BURSTS);
+        persist_write_int(PERSIST_KEY_BURST_MS, (int32_t)(burst_s * 1000));
+    }
+
+    init();
+    if (obstruct_rows > 0) {
+        host_set_unobstructed_area(GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT - obstruct_rows));
+    }
+    host_stats_reset();
+    host_gfx_counters_reset();
+    s_culled_draws = 0;
+    uint64_t start_ms = host_clock_now_ms();
+
+    // Track the busiest frame by diffing the running counters per render
+    uint64_t last_renders = 0;
+    uint64_t last_pixels = 0;
+    uint64_t last_primitives = 0;
+    uint64_t peak_pixels = 0;
+    uint64_t peak_primitives = 0;
+
+    // Frames rendered at each rung of the governor's ladder
+    uint64_t rung_frames[FRAME_LADDER_RUNGS] = {0};
+
+    uint64_t next_tap_ms = start_ms;
+    while ((long)host_stats()->timer_fires < ticks) {
+        if (tap_every_s > 0 && !host_tap_pending()) {
+            next_tap_ms += (uint64_t)tap_every_s * 1000;
+            host_schedule_tap(next_tap_ms, ACCEL_AXIS_X, 1);
+        } else if (tap_every_s <= 0 && s_settings.mode == ANIMATION_CONTINUOUS &&
+                   s_animation_state != ANIMATION_BURST) {
+            fprintf(stderr, "sim: idle after %llu ticks\n",
+                    (unsigned long long)host_stats()->timer_fires);
+            break;
+        }
+        if (!host_step()) {
+            fprintf(stderr, "sim: no pending events after %llu ticks\n",
+                    (unsigned long long)host_stats()->timer_fires);
+            break;
+        }
+
+        if (host_stats()->renders != last_renders) {
+            const HostGfxCounters *gfx = host_gfx_counters();
+            uint64_t primitives = count_primitives(gfx);
+            if (gfx->pixels - last_pixels > peak_pixels) peak_pixels = gfx->pixels - last_pixels;
+            if (primitives - last_primitives > peak_primitives) peak_primitives = primitives - last_primitives;
+            last_renders = host_stats()->renders;
+            last_pixels = gfx->pixels;
+            last_primitives = primitives;
+
+            for (int r = 0; r < FRAME_LADDER_RUNGS; r++) {
+                if (s_frame_ladder[r] == s_governor.interval_ms) rung_frames[r]++;
+            }
+        }
+    }
+
+    const HostStats *stats = host_stats();
+    uint64_t fires = stats->timer_fires ? stats->timer_fires : 1;
+    uint64_t renders = stats->renders ? stats->renders : 1;
+    printf("ticks=%llu renders=%llu minute_ticks=%llu taps=%llu simulated_ms=%llu\n",
+           (unsigned long long)stats->timer_fires,
+           (unsigned long long)stats->renders,
+           (unsigned long long)stats->tick_events,
+           (unsigned long long)stats->tap_events,
+           (unsigned long long)(host_clock_now_ms() - start_ms));
+    printf("update_ns_per_tick=%llu render_ns_per_frame=%llu\n",
+           (unsigned long long)(stats->timer_ns / fires),
+           (unsigned long long)(stats->render_ns / renders));
+
+    // Primitive counts per rendered frame
+    const HostGfxCounters *gfx = host_gfx_counters();
+    printf("per_frame: fill_circle=%.1f draw_circle=%.1f draw_line=%.1f gpath_filled=%.1f "
+           "fill_rect=%.1f draw_rect=%.1f draw_bitmap=%.1f\n",
+           (double)gfx->fill_circle / renders, (double)gfx->draw_circle / renders,
+           (double)gfx->draw_line / renders, (double)gfx->gpath_filled / renders,
+           (double)gfx->fill_rect / renders, (double)gfx->draw_rect / renders,
+           (double)gfx->draw_bitmap / renders);
+    printf("per_frame: color_sets=%.1f stroke_width_sets=%.1f redundant_sets=%.1f pixels=%.1f\n",
+           (double)gfx->color_sets / renders, (double)gfx->stroke_width_sets / renders,
+           (double)gfx->redundant_sets / renders, (double)gfx->pixels / renders);
+    printf("peak_frame: primitives=%llu pixels=%llu\n",
+           (unsigned long long)peak_primitives, (unsigned long long)peak_pixels);
+    printf("culling: culled_per_frame=%.1f\n", (double)s_culled_draws / renders);
+
+    // Governor telemetry: where it ended up and how it spent the run. The
+    // virtual clock doesn't move while app code runs, so the measured cost
+    // is always 0 here and only battery and scene activity steer it.
+    printf("governor: interval_ms=%u cost_ms=%u frames_at_interval_ms:",
+           s_governor.interval_ms, s_governor.cost_ms);
+    for (int r = 0; r < FRAME_LADDER_RUNGS; r++) {
+        printf(" %u=%llu", s_frame_ladder[r], (unsigned long long)rung_frames[r]);
+    }
+    printf("\n");
+
+    deinit();
+    return 0;
+}
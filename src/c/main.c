@@ -1,84 +1,5 @@
 #include <pebble.h>
 
-// Structures for animated elements
-typedef struct {
-    GPoint pos;
-    int direction;  // 1 for right, -1 for left
-    int speed;
-    bool active;    // Whether the fish is alive/visible
-    int size;       // Size of the fish (1 = small, 2 = big)
-    int grid_cell;  // Cell in the spatial grid for faster collision detection
-} Fish;
-
-typedef struct {
-    GPoint base;
-    int offset;
-    int speed;
-} Seaweed;
-
-typedef struct {
-    GPoint pos;
-    int size;
-    int speed;
-    bool active;
-} Bubble;
-
-typedef struct {
-    GPoint pos;
-    int direction;
-    int speed;
-    bool active;
-} Plankton;
-
-typedef struct {
-    GPoint pos;
-    int direction;   // 1 for right, -1 for left
-    int tentacle_offset;
-    int speed;
-} Octopus;
-
-typedef struct {
-    GPoint pos;
-    int direction;   // 1 for right, -1 for left
-    int animation_offset;
-    int speed;
-} Turtle;
-
-typedef struct {
-    GPoint pos;
-    int tentacle_offset;
-    int pulse_state;
-    int speed;
-} Jellyfish;
-
-typedef struct {
-    GPoint pos;
-    int direction;      // 1 for right, -1 for left
-    int jaw_state;      // Animation state for opening/closing mouth
-    int speed;
-    bool active;        // Only appears occasionally
-    int timer;          // Countdown for appearance
-} Shark;
-
-typedef struct {
-    GPoint pos;
-    int curve_state;    // Animation for curved body
-    bool active;        // Only appears occasionally
-    int timer;          // Countdown for appearance/disappearance
-} Seahorse;
-
-typedef struct {
-    GPoint pos;
-    int direction;   // 1 for right, -1 for left
-    int claw_state;  // For animating claws
-    int speed;
-} Crab;
-
-typedef struct {
-    GPoint pos;
-    int open_state;  // For occasional opening/closing
-} Clam;
-
 // UI Elements
 static Window *s_main_window;
 static Layer *s_canvas_layer;
@@ -108,40 +29,436 @@ static GPoint s_shark_tail_points[3];
 static GPoint s_shark_fin_points[3];
 
 // Animation elements
-#define MAX_FISH 5         // Increased for more fish
+// How many of each creature the scene holds is fixed per build. The wscript
+// picks a profile for each platform (lean on aplite, rich on the others) and
+// AQUA_POPULATION=eco selects the battery-saving one everywhere; builds
+// without it get the lean scene.
+#define POPULATION_LEAN 0   // aplite: 24 KB of app RAM and the slowest CPU
+#define POPULATION_RICH 1   // basalt, chalk, diorite
+#define POPULATION_ECO 2    // A sparse scene for the longest battery life
+
+#ifndef POPULATION_PROFILE
+#define POPULATION_PROFILE POPULATION_LEAN
+#endif
+
+#if POPULATION_PROFILE == POPULATION_RICH
+#define MAX_FISH 8
+#define MAX_BIG_FISH 3     // Big fish that eat small fish
+#define MAX_SEAWEED 6
+#define MAX_BUBBLES 12
+#define MAX_PLANKTON 10
+#define MAX_TURTLES 2
+#define MAX_JELLYFISH 2
+#elif POPULATION_PROFILE == POPULATION_ECO
+#define MAX_FISH 3
+#define MAX_BIG_FISH 1     // Big fish that eat small fish
+#define MAX_SEAWEED 3
+#define MAX_BUBBLES 4
+#define MAX_PLANKTON 3
+#define MAX_TURTLES 1
+#define MAX_JELLYFISH 1
+#else
+#define MAX_FISH 5
 #define MAX_BIG_FISH 2     // Big fish that eat small fish
 #define MAX_SEAWEED 4
 #define MAX_BUBBLES 8
 #define MAX_PLANKTON 6
 #define MAX_TURTLES 1
-#define MAX_JELLYFISH 1    // Reduced to one jellyfish
-static Fish s_fish[MAX_FISH + MAX_BIG_FISH];  // Combined array for all fish
-static Seaweed s_seaweed[MAX_SEAWEED];
-static Bubble s_bubbles[MAX_BUBBLES];
-static Plankton s_plankton[MAX_PLANKTON];
-static Octopus s_octopus;
-static Turtle s_turtles[MAX_TURTLES];
-static Jellyfish s_jellyfish[MAX_JELLYFISH];
-static Shark s_shark;      // One shark is enough!
-static Seahorse s_seahorse; // One seahorse
-static Crab s_crab;        // Tiny crab at the bottom
-static Clam s_clam;        // Small clam
+#define MAX_JELLYFISH 1
+#endif
+
+// Entity store
+// Every creature lives in one set of parallel arrays indexed by entity id,
+// so update loops walk dense, narrow arrays instead of a padded struct of
+// ints per species. Ids are grouped by species in drawing order (back to
+// front) and double as draw slots.
+enum {
+    ENTITY_SEAWEED = 0,
+    ENTITY_CLAM = ENTITY_SEAWEED + MAX_SEAWEED,  // Small clam
+    ENTITY_CRAB,                                 // Tiny crab at the bottom
+    ENTITY_PLANKTON,
+    ENTITY_TURTLE = ENTITY_PLANKTON + MAX_PLANKTON,
+    ENTITY_JELLYFISH = ENTITY_TURTLE + MAX_TURTLES,
+    ENTITY_SEAHORSE = ENTITY_JELLYFISH + MAX_JELLYFISH,
+    ENTITY_FISH,                                 // Small fish, then big fish that eat them
+    ENTITY_BIG_FISH = ENTITY_FISH + MAX_FISH,
+    ENTITY_BUBBLE = ENTITY_BIG_FISH + MAX_BIG_FISH,
+    ENTITY_OCTOPUS = ENTITY_BUBBLE + MAX_BUBBLES,
+    ENTITY_SHARK,                                // One shark is enough!
+    ENTITY_COUNT
+};
+
+// Direction, speed, the active flag and a size share one byte per entity;
+// go through the accessors below rather than the bits
+#define MOTION_SPEED_MASK 0x07      // Pixels per step, 0-7
+#define MOTION_LEFT 0x08            // Facing left; right otherwise
+#define MOTION_ACTIVE 0x10          // Alive/visible
+#define MOTION_SIZE_SHIFT 5         // Size, 0-7 (bubbles)
+#define MOTION_SIZE_MASK (0x07 << MOTION_SIZE_SHIFT)
+
+typedef struct {
+    int16_t x[ENTITY_COUNT];
+    int16_t y[ENTITY_COUNT];                // Seaweed: bottom of the strand
+    uint16_t phase[ENTITY_COUNT];           // Animation cycle: sway, tentacles, claws, clam opening
+    uint8_t motion[ENTITY_COUNT];           // MOTION_* bits
+} EntityStore;
+
+static EntityStore s_entities;
+
+// State only one species has
+static uint8_t s_jellyfish_pulse[MAX_JELLYFISH];
+static int16_t s_shark_timer;               // Countdown for appearance
+
+static void motion_set(int id, uint8_t mask, uint8_t bits) {
+    s_entities.motion[id] = (s_entities.motion[id] & ~mask) | (bits & mask);
+}
+
+// Kinds of creature, for tables shared by every entity of a kind
+typedef enum {
+    SPECIES_SEAWEED,
+    SPECIES_CLAM,
+    SPECIES_CRAB,
+    SPECIES_PLANKTON,
+    SPECIES_TURTLE,
+    SPECIES_JELLYFISH,
+    SPECIES_SEAHORSE,
+    SPECIES_FISH,           // Small and big
+    SPECIES_BUBBLE,
+    SPECIES_OCTOPUS,
+    SPECIES_SHARK,
+    SPECIES_COUNT
+} Species;
+
+static Species entity_species(int id) {
+    if (id < ENTITY_CLAM) return SPECIES_SEAWEED;
+    if (id == ENTITY_CLAM) return SPECIES_CLAM;
+    if (id == ENTITY_CRAB) return SPECIES_CRAB;
+    if (id < ENTITY_TURTLE) return SPECIES_PLANKTON;
+    if (id < ENTITY_JELLYFISH) return SPECIES_TURTLE;
+    if (id < ENTITY_SEAHORSE) return SPECIES_JELLYFISH;
+    if (id == ENTITY_SEAHORSE) return SPECIES_SEAHORSE;
+    if (id < ENTITY_BUBBLE) return SPECIES_FISH;
+    if (id < ENTITY_OCTOPUS) return SPECIES_BUBBLE;
+    if (id == ENTITY_OCTOPUS) return SPECIES_OCTOPUS;
+    return SPECIES_SHARK;
+}
+
+static GPoint entity_pos(int id) {
+    return GPoint(s_entities.x[id], s_entities.y[id]);
+}
+
+static void entity_set_pos(int id, GPoint pos) {
+    s_entities.x[id] = pos.x;
+    s_entities.y[id] = pos.y;
+}
+
+static bool entity_active(int id) {
+    return s_entities.motion[id] & MOTION_ACTIVE;
+}
+
+static void entity_set_active(int id, bool active) {
+    motion_set(id, MOTION_ACTIVE, active ? MOTION_ACTIVE : 0);
+}
+
+// 1 for right, -1 for left
+static int entity_direction(int id) {
+    return (s_entities.motion[id] & MOTION_LEFT) ? -1 : 1;
+}
+
+static void entity_set_direction(int id, int direction) {
+    motion_set(id, MOTION_LEFT, direction < 0 ? MOTION_LEFT : 0);
+}
+
+static int entity_speed(int id) {
+    return s_entities.motion[id] & MOTION_SPEED_MASK;
+}
+
+static void entity_set_speed(int id, int speed) {
+    motion_set(id, MOTION_SPEED_MASK, speed);
+}
+
+static int entity_size(int id) {
+    return (s_entities.motion[id] & MOTION_SIZE_MASK) >> MOTION_SIZE_SHIFT;
+}
+
+static void entity_set_size(int id, int size) {
+    motion_set(id, MOTION_SIZE_MASK, size << MOTION_SIZE_SHIFT);
+}
+
+// Big fish are almost twice the size
+static bool fish_is_big(int id) {
+    return id >= ENTITY_BIG_FISH;
+}
+
+// Seaweed strands are a chain of short line segments
+#define SEAWEED_SEGMENTS 6
+#define SEAWEED_SEGMENT_LENGTH 10
 
 // Update frequency
-#define ANIMATION_INTERVAL 50
-#define ANIMATION_INTERVAL_LOW_POWER 100  // Slower updates when battery is low
+// The simulation advances in fixed steps of wall time however often frames
+// are rendered, so a lower frame rate or a late timer doesn't slow anything down
+#define SIM_STEP_MS 50            // Creature speeds are in pixels per step
+#define MAX_CATCHUP_STEPS 20      // Further behind than this, the backlog is skipped
+#define ANIMATION_INTERVAL 50     // Time between frames until the governor has measured one
 #define LOW_BATTERY_THRESHOLD 20  // Consider battery low at 20%
 
-// Spatial grid for collision detection optimization
+static int64_t s_sim_time_ms;     // Wall time the simulation has been advanced to
+
+// Frame-rate governor
+// Chooses the time between frames from a ladder of intervals. The battery
+// sets how often we'd like to draw, a quiet scene doubles that interval,
+// and the measured cost of a frame sets how often we can afford to. Nothing
+// changes between simulation steps, so no interval is shorter than one.
+#ifndef FRAME_INTERVAL_LADDER
+#define FRAME_INTERVAL_LADDER 50, 100, 250, 1000
+#endif
+#define FRAME_BUDGET_PERCENT 25         // Share of each interval a frame may spend working
+#define GOOD_BATTERY_THRESHOLD 50       // Above this, full frame rate
+#define CRITICAL_BATTERY_THRESHOLD 10   // At or below this, about one frame a second
+#define CALM_FISH_COUNT 4               // No shark and at most this many fish is a quiet scene
+
+static const uint16_t s_frame_ladder[] = { FRAME_INTERVAL_LADDER };
+#define FRAME_LADDER_RUNGS ((int)(sizeof(s_frame_ladder) / sizeof(s_frame_ladder[0])))
+
+// What the governor measured and chose; kept up to date for telemetry
+typedef struct {
+    uint16_t interval_ms;   // Current time between frames
+    uint16_t update_ms;     // Simulation time of the last frame
+    uint16_t render_ms;     // Canvas render time of the last frame
+    uint16_t cost_ms;       // Smoothed update + render time
+    uint16_t cost_x16;      // cost_ms in 1/16 ms, for the running average
+} FrameGovernor;
+
+static FrameGovernor s_governor = { .interval_ms = ANIMATION_INTERVAL };
+
+// Animation scheduling
+// The aquarium is only looked at for a few seconds per glance, so it animates
+// in bursts and otherwise leaves its last frame on screen with only the minute
+// tick to wake us. Continuous mode runs a burst until IDLE_TIMEOUT_MS passes
+// without a tap or wrist flick; burst mode also starts one on every minute
+// change and lets it run for a fixed time, followed by a cooldown in which
+// nothing restarts it, so the animation can't use more than a known share of
+// the battery.
+#ifndef IDLE_TIMEOUT_MS
+#define IDLE_TIMEOUT_MS 30000     // 0 keeps the animation running
+#endif
+
+typedef enum {
+    ANIMATION_CONTINUOUS = 0,     // Animate until idle, wake on a tap
+    ANIMATION_BURSTS = 1,         // Animate briefly after each minute change or tap
+} AnimationMode;
+
+#ifndef DEFAULT_ANIMATION_MODE
+#define DEFAULT_ANIMATION_MODE ANIMATION_CONTINUOUS
+#endif
+#define DEFAULT_BURST_MS 8000
+#define DEFAULT_COOLDOWN_MS 2000
+#define MIN_BURST_MS 1000
+#define MAX_BURST_MS 60000
+#define MAX_COOLDOWN_MS 600000
+
+// Persistent storage keys
+#define PERSIST_KEY_ANIMATION_MODE 1
+#define PERSIST_KEY_BURST_MS 2
+#define PERSIST_KEY_COOLDOWN_MS 3
+
+typedef struct {
+    int32_t mode;           // AnimationMode
+    int32_t burst_ms;       // Length of a burst in burst mode
+    int32_t cooldown_ms;    // Quiet time after a burst in burst mode
+} AnimationSettings;
+
+static AnimationSettings s_settings = {
+    .mode = DEFAULT_ANIMATION_MODE,
+    .burst_ms = DEFAULT_BURST_MS,
+    .cooldown_ms = DEFAULT_COOLDOWN_MS,
+};
+
+typedef enum {
+    ANIMATION_IDLE,         // Last frame on screen, no timer
+    ANIMATION_BURST,        // Animating until s_animation_until_ms
+    ANIMATION_COOLDOWN,     // No timer, and triggers ignored until s_animation_until_ms
+} AnimationState;
+
+static AnimationState s_animation_state;
+static int64_t s_animation_until_ms;
+static bool s_in_focus = true;      // False while a notification or other window covers us
+
+// Wall clock in milliseconds
+static int64_t clock_now_ms(void) {
+    time_t seconds;
+    uint16_t millis;
+    time_ms(&seconds, &millis);
+    return (int64_t)seconds * 1000 + millis;
+}
+
+// Scene geometry
+// The layout was designed on the 144x168 rectangular screens. Everything is
+// placed relative to the canvas measured at load instead: edges and the sea
+// floor move with the canvas, and positions inside it scale with its size.
+#define SCENE_DESIGN_WIDTH 144
+#define SCENE_DESIGN_HEIGHT 168
+
+typedef struct {
+    int16_t width;          // Canvas size
+    int16_t height;
+    GPoint center;
+    int16_t radius;         // Visible circle on round displays, 0 elsewhere
+    int16_t grid_cell_width;
+    int16_t grid_cell_height;
+    int16_t swim_top;       // Rows swimmers spawn in: where the screen is
+    int16_t swim_bottom;    // at least SWIM_MIN_SPAN_PERCENT wide
+} SceneGeometry;
+
+// Swimmers are kept to rows where most of the screen's width can be seen
+#define SWIM_MIN_SPAN_PERCENT 75
+
+#if defined(PBL_ROUND)
+// Visible pixels of each canvas row on a round display, [left, right)
+static uint8_t s_row_left[PBL_DISPLAY_HEIGHT];
+static uint8_t s_row_right[PBL_DISPLAY_HEIGHT];
+#endif
+
+// Spatial grid for the collision broad phase
 #define GRID_WIDTH 3
 #define GRID_HEIGHT 3
-#define GRID_CELL_WIDTH 144 / GRID_WIDTH
-#define GRID_CELL_HEIGHT 168 / GRID_HEIGHT
 #define GRID_CELL_COUNT (GRID_WIDTH * GRID_HEIGHT)
 
-// Track which fish are in which grid cells to optimize collision detection
-static int s_fish_in_grid[GRID_CELL_COUNT][MAX_FISH + MAX_BIG_FISH];
-static int s_fish_grid_counts[GRID_CELL_COUNT];
+static SceneGeometry s_scene;
+
+// Measure the canvas and size everything that depends on it
+static void scene_geometry_init(GRect bounds) {
+    s_scene.width = bounds.size.w;
+    s_scene.height = bounds.size.h;
+    s_scene.center = GPoint(bounds.size.w / 2, bounds.size.h / 2);
+    s_scene.radius = PBL_IF_ROUND_ELSE((bounds.size.w < bounds.size.h ? bounds.size.w : bounds.size.h) / 2, 0);
+    s_scene.grid_cell_width = bounds.size.w / GRID_WIDTH;
+    s_scene.grid_cell_height = bounds.size.h / GRID_HEIGHT;
+    s_scene.swim_top = 0;
+    s_scene.swim_bottom = bounds.size.h - 1;
+    
+#if defined(PBL_ROUND)
+    // A pixel shows if its center is inside the circle; work in half pixels
+    // so the centers are whole numbers
+    int radius2 = s_scene.radius * 2;
+    int min_span = bounds.size.w * SWIM_MIN_SPAN_PERCENT / 100;
+    s_scene.swim_top = -1;
+    for (int y = 0; y < bounds.size.h && y < PBL_DISPLAY_HEIGHT; y++) {
+        int dy = 2 * y + 1 - 2 * s_scene.center.y;
+        int left = s_scene.center.x;
+        while (left > 0) {
+            int dx = 2 * (left - 1) + 1 - 2 * s_scene.center.x;
+            if (dx * dx + dy * dy > radius2 * radius2) break;
+            left--;
+        }
+        int right = bounds.size.w - left;
+        s_row_left[y] = left;
+        s_row_right[y] = right > left ? right : left;
+        
+        if (right - left >= min_span) {
+            if (s_scene.swim_top < 0) s_scene.swim_top = y;
+            s_scene.swim_bottom = y;
+        }
+    }
+    if (s_scene.swim_top < 0) s_scene.swim_top = 0;
+#endif
+}
+
+// First visible x on a row, and one past the last
+static int scene_row_left(int y) {
+#if defined(PBL_ROUND)
+    if (y >= 0 && y < s_scene.height && y < PBL_DISPLAY_HEIGHT) return s_row_left[y];
+#endif
+    return 0;
+}
+
+static int scene_row_right(int y) {
+#if defined(PBL_ROUND)
+    if (y >= 0 && y < s_scene.height && y < PBL_DISPLAY_HEIGHT) return s_row_right[y];
+#endif
+    return s_scene.width;
+}
+
+// A position on the design screen, moved to the same place on this canvas
+static int scene_x(int x) {
+    return x * s_scene.width / SCENE_DESIGN_WIDTH;
+}
+
+static int scene_y(int y) {
+    return y * s_scene.height / SCENE_DESIGN_HEIGHT;
+}
+
+// Whether any of rect lies on the visible part of the display; on round
+// ones the corners of the canvas can't be seen
+static bool scene_rect_visible(GRect rect) {
+#if defined(PBL_ROUND)
+    int top = rect.origin.y;
+    int bottom = rect.origin.y + rect.size.h - 1;
+    if (rect.size.w <= 0 || bottom < 0 || top >= s_scene.height) return false;
+    
+    // The row nearest the middle is the widest one the rect covers
+    int y = s_scene.center.y;
+    if (y < top) y = top;
+    if (y > bottom) y = bottom;
+    return rect.origin.x < scene_row_right(y) && rect.origin.x + rect.size.w > scene_row_left(y);
+#else
+    return true;
+#endif
+}
+
+// Collision broad phase
+// Everything that can be eaten is binned by category and grid cell once per
+// step. A predator asks for the categories it eats within its own reach and
+// gets back only the entities in the cells that reach overlaps, so the cost
+// of predation grows with how crowded the water is around it rather than
+// with the population.
+typedef enum {
+    CATEGORY_SMALL_FISH,
+    CATEGORY_BIG_FISH,
+    CATEGORY_COUNT
+} Category;
+
+#define CATEGORY_MASK(category) (1 << (category))
+#define BROADPHASE_FIRST ENTITY_FISH      // Entities with a category are
+#define BROADPHASE_END ENTITY_BUBBLE      // [BROADPHASE_FIRST, BROADPHASE_END)
+#define BROADPHASE_BUCKETS (GRID_CELL_COUNT * CATEGORY_COUNT)
+
+// Entity ids sorted by bucket (cell, then category), ascending within each;
+// bucket b holds s_broadphase_ids[s_broadphase_start[b] .. s_broadphase_start[b + 1])
+static uint8_t s_broadphase_start[BROADPHASE_BUCKETS + 1];
+static uint8_t s_broadphase_ids[BROADPHASE_END - BROADPHASE_FIRST];
+
+// Random number generator state (xorshift32)
+// Self-contained so every roll is a few shifts instead of a libc call, and a
+// given seed always replays the same aquarium.
+typedef struct {
+    uint32_t state;
+} RandomState;
+
+static RandomState s_random;
+
+// Seed the generator; nearby seeds (e.g. consecutive timestamps) are mixed so
+// they don't start out correlated
+static void random_seed(RandomState *random, uint32_t seed) {
+    seed ^= seed >> 16;
+    seed *= 0x7feb352d;
+    seed ^= seed >> 15;
+    seed *= 0x846ca68b;
+    seed ^= seed >> 16;
+    
+    // Zero is a fixed point of xorshift, so never store it
+    random->state = seed ? seed : 0x6d2b79f5;
+}
+
+// Next 32 random bits
+static uint32_t random_next(RandomState *random) {
+    uint32_t x = random->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    random->state = x;
+    return x;
+}
 
 // Helper function for safer random number generation within a range
 static int random_in_range(int min, int max) {
@@ -152,539 +469,1014 @@ static int random_in_range(int min, int max) {
     int range = max - min + 1;
     if (range <= 0) return min; // Overflow protection
     
-    // Use modulo for smaller range with overflow protection
-    uint32_t random_val = (uint32_t)rand() % (uint32_t)range;
+    // Scale the 32 random bits into the range with a multiply instead of a modulo
+    uint32_t random_val = (uint32_t)(((uint64_t)random_next(&s_random) * (uint32_t)range) >> 32);
     return min + (int)random_val;
 }
 
+// A random row in the given range of the design screen for something
+// swimming across, kept to rows where its crossing can be seen
+static int scene_swim_y(int design_min, int design_max) {
+    int min = scene_y(design_min);
+    int max = scene_y(design_max);
+    if (min < s_scene.swim_top) min = s_scene.swim_top;
+    if (max > s_scene.swim_bottom) max = s_scene.swim_bottom;
+    if (max < min) max = min;
+    return random_in_range(min, max);
+}
+
 // Initialize a fish with random position and speed
-static void init_fish(Fish *fish, int size) {
-    fish->pos.y = random_in_range(20, 119); // Between 20 and 119
-    fish->direction = (random_in_range(0, 1) * 2) - 1;  // Either 1 or -1
-    fish->speed = size == 1 ? 
-                 random_in_range(2, 4) : 
-                 random_in_range(1, 2);  // Big fish are slower
-    fish->pos.x = (fish->direction == 1) ? -10 : 144;  // Use screen width constant
-    fish->active = true;
-    fish->size = size;
+static void init_fish(int id) {
+    s_entities.y[id] = scene_swim_y(20, 119); // Middle of the water
+    entity_set_direction(id, (random_in_range(0, 1) * 2) - 1);  // Either 1 or -1
+    entity_set_speed(id, !fish_is_big(id) ? 
+                           random_in_range(2, 4) : 
+                           random_in_range(1, 2));  // Big fish are slower
+    s_entities.x[id] = (entity_direction(id) == 1) ?  // Just off screen
+                       scene_row_left(s_entities.y[id]) - 10 : scene_row_right(s_entities.y[id]);
+    entity_set_active(id, true);
 }
 
 // Initialize seaweed with base position
-static void init_seaweed(Seaweed *seaweed, int x) {
-    seaweed->base.x = x;
-    seaweed->base.y = 168;  // Screen height
-    seaweed->offset = 0;
-    seaweed->speed = random_in_range(1, 2);
+static void init_seaweed(int id, int x) {
+    s_entities.x[id] = x;
+    s_entities.y[id] = s_scene.height;  // Rooted on the sea floor
+    s_entities.phase[id] = 0;
+    entity_set_speed(id, random_in_range(1, 2));
+    entity_set_active(id, true);
 }
 
 // Initialize bubble
-static void init_bubble(Bubble *bubble) {
-    bubble->pos.x = random_in_range(0, 143);  // Random x position
-    bubble->pos.y = 168;           // Start at bottom
-    bubble->size = random_in_range(1, 3);
-    bubble->speed = random_in_range(1, 3);
-    bubble->active = true;
+static void init_bubble(int id) {
+    s_entities.x[id] = random_in_range(0, s_scene.width - 1);  // Random x position
+    s_entities.y[id] = s_scene.height;  // Start at bottom
+    entity_set_size(id, random_in_range(1, 3));
+    entity_set_speed(id, random_in_range(1, 3));
+    entity_set_active(id, true);
 }
 
 // Initialize plankton
-static void init_plankton(Plankton *plankton) {
-    plankton->pos.x = random_in_range(0, 143);
-    plankton->pos.y = random_in_range(20, 139);
-    plankton->direction = (random_in_range(0, 1) * 2) - 1;  // Either 1 or -1
-    plankton->speed = random_in_range(1, 2);
-    plankton->active = true;
+static void init_plankton(int id) {
+    s_entities.x[id] = random_in_range(0, s_scene.width - 1);
+    s_entities.y[id] = random_in_range(scene_y(20), scene_y(139));
+    entity_set_direction(id, (random_in_range(0, 1) * 2) - 1);  // Either 1 or -1
+    entity_set_speed(id, random_in_range(1, 2));
+    entity_set_active(id, true);
 }
 
 // Initialize octopus
-static void init_octopus(Octopus *octopus) {
-    octopus->pos.x = random_in_range(37, 106);  // Somewhere in the middle
-    octopus->pos.y = 25;                // Near the top (moved from bottom)
-    octopus->direction = (random_in_range(0, 1) * 2) - 1;
-    octopus->tentacle_offset = 0;
-    octopus->speed = 1;
+static void init_octopus(void) {
+    s_entities.x[ENTITY_OCTOPUS] = random_in_range(scene_x(37), scene_x(106));  // Somewhere in the middle
+    s_entities.y[ENTITY_OCTOPUS] = scene_y(25);       // Near the top (moved from bottom)
+    entity_set_direction(ENTITY_OCTOPUS, (random_in_range(0, 1) * 2) - 1);
+    s_entities.phase[ENTITY_OCTOPUS] = 0;
+    entity_set_speed(ENTITY_OCTOPUS, 1);
+    entity_set_active(ENTITY_OCTOPUS, true);
 }
 
 // Initialize turtle
-static void init_turtle(Turtle *turtle) {
-    turtle->pos.y = random_in_range(60, 119);  // Middle to bottom area
-    turtle->direction = (random_in_range(0, 1) * 2) - 1;  // Either 1 or -1
-    turtle->pos.x = (turtle->direction == 1) ? -15 : 144;  // Start offscreen
-    turtle->animation_offset = 0;
-    turtle->speed = 1;  // Turtles are slow
+static void init_turtle(int id) {
+    s_entities.y[id] = scene_swim_y(60, 119);  // Middle to bottom area
+    entity_set_direction(id, (random_in_range(0, 1) * 2) - 1);  // Either 1 or -1
+    s_entities.x[id] = (entity_direction(id) == 1) ?  // Start offscreen
+                       scene_row_left(s_entities.y[id]) - 15 : scene_row_right(s_entities.y[id]);
+    s_entities.phase[id] = 0;
+    entity_set_speed(id, 1);  // Turtles are slow
+    entity_set_active(id, true);
 }
 
 // Initialize jellyfish
-static void init_jellyfish(Jellyfish *jellyfish) {
-    jellyfish->pos.x = 72;  // Center horizontally
-    jellyfish->pos.y = 120;  // Lower part but not too low
-    jellyfish->tentacle_offset = 0;
-    jellyfish->pulse_state = 0;
-    jellyfish->speed = random_in_range(1, 2);
+static void init_jellyfish(int id) {
+    // Evenly spaced across the screen; a lone jellyfish is centered
+    int k = id - ENTITY_JELLYFISH;
+    s_entities.x[id] = (s_scene.width * (2 * k + 1)) / (2 * MAX_JELLYFISH);
+    s_entities.y[id] = scene_y(120);  // Lower part but not too low
+    s_entities.phase[id] = 0;
+    s_jellyfish_pulse[id - ENTITY_JELLYFISH] = 0;
+    entity_set_speed(id, random_in_range(1, 2));
+    entity_set_active(id, true);
 }
 
 // Initialize shark
-static void init_shark(Shark *shark) {
-    shark->direction = (random_in_range(0, 1) * 2) - 1;  // Either 1 or -1
-    shark->pos.x = (shark->direction == 1) ? -30 : 174;  // Start further offscreen
-    shark->pos.y = random_in_range(50, 99);  // Middle area of screen
-    shark->jaw_state = 0;  // Mouth closed
-    shark->speed = 3;  // Sharks are fast!
-    shark->active = false;  // Start inactive
-    shark->timer = random_in_range(150, 299);  // Reduced timer - appear more often (2.5-5 seconds)
+static void init_shark(void) {
+    entity_set_direction(ENTITY_SHARK, (random_in_range(0, 1) * 2) - 1);  // Either 1 or -1
+    s_entities.y[ENTITY_SHARK] = scene_swim_y(50, 99);  // Middle area of screen
+    int y = s_entities.y[ENTITY_SHARK];
+    s_entities.x[ENTITY_SHARK] = (entity_direction(ENTITY_SHARK) == 1) ?  // Start further offscreen
+                                 scene_row_left(y) - 30 : scene_row_right(y) + 30;
+    entity_set_speed(ENTITY_SHARK, 3);  // Sharks are fast!
+    entity_set_active(ENTITY_SHARK, false);  // Start inactive
+    s_shark_timer = random_in_range(150, 299);  // Reduced timer - appear more often (2.5-5 seconds)
 }
 
 // Initialize seahorse
-static void init_seahorse(Seahorse *seahorse) {
-    seahorse->pos.x = 20;  // Fixed position at left side
-    seahorse->pos.y = 140; // Bottom left corner
-    seahorse->curve_state = 0;
-    seahorse->active = true;
-    seahorse->timer = 0;   // Not used for disappearing anymore
+static void init_seahorse(void) {
+    s_entities.x[ENTITY_SEAHORSE] = scene_x(20);  // Fixed position at left side
+    s_entities.y[ENTITY_SEAHORSE] = s_scene.height - 28; // Bottom left corner
+    s_entities.phase[ENTITY_SEAHORSE] = 0;
+    entity_set_active(ENTITY_SEAHORSE, true);
 }
 
 // Initialize crab
-static void init_crab(Crab *crab) {
-    crab->pos.x = 100;  // Start around the middle-right
-    crab->pos.y = 160;  // Very close to bottom
-    crab->direction = -1;  // Start moving left
-    crab->claw_state = 0;
-    crab->speed = 1;
+static void init_crab(void) {
+    s_entities.x[ENTITY_CRAB] = scene_x(100);  // Start around the middle-right
+    s_entities.y[ENTITY_CRAB] = s_scene.height - 8;  // Very close to bottom
+    entity_set_direction(ENTITY_CRAB, -1);  // Start moving left
+    s_entities.phase[ENTITY_CRAB] = 0;
+    entity_set_speed(ENTITY_CRAB, 1);
+    entity_set_active(ENTITY_CRAB, true);
 }
 
 // Initialize clam
-static void init_clam(Clam *clam) {
-    clam->pos.x = 120;  // Right side of bottom
-    clam->pos.y = 165;  // Very bottom
-    clam->open_state = 0;
+static void init_clam(void) {
+    s_entities.x[ENTITY_CLAM] = scene_x(120);  // Right side of bottom
+    s_entities.y[ENTITY_CLAM] = s_scene.height - 3;  // Very bottom
+    s_entities.phase[ENTITY_CLAM] = 0;
+    entity_set_active(ENTITY_CLAM, true);
 }
 
 // Forward declarations for update functions
-static void update_seahorse(Seahorse *seahorse);
-static void update_crab(Crab *crab);
-static void update_clam(Clam *clam);
-static void update_turtle(Turtle *turtle);
-static void update_jellyfish(Jellyfish *jellyfish);
-static void update_octopus(Octopus *octopus);
+static void update_seahorse(void);
+static void update_crab(void);
+static void update_clam(void);
+static void update_turtle(int id);
+static void update_jellyfish(int id);
+static void update_octopus(void);
 
 // Update seahorse
-static void update_seahorse(Seahorse *seahorse) {
+static void update_seahorse(void) {
     // Only animate the seahorse's body with gentle swaying
     // Apply modulo immediately to prevent overflow
-    seahorse->curve_state = (seahorse->curve_state + 1) % TRIG_MAX_ANGLE;
+    s_entities.phase[ENTITY_SEAHORSE] = (s_entities.phase[ENTITY_SEAHORSE] + 1) % TRIG_MAX_ANGLE;
     
     // Always keep active
-    seahorse->active = true;
+    entity_set_active(ENTITY_SEAHORSE, true);
 }
 
-// Draw fish with safety check
-static void draw_fish(GContext *ctx, const Fish *fish) {
-    if (!fish || !fish->active) return;
-    
-    // Set fill color (white for B&W displays)
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    
-    int size = fish->size == 1 ? 4 : 7;  // Size difference for big fish
+// Render batching
+// The draw routines switch fill color, stroke color and width several times
+// per creature (white body, black eye, white again). While canvas_draw
+// repaints, their primitives are recorded into a small command list along
+// with the state each one needs, instead of going to the graphics API. A
+// flush sorts the list into one batch per state, moving a command up to an
+// earlier batch only past commands it doesn't overlap, so the layering comes
+// out the same with far fewer state changes. Outside a repaint, such as
+// while sprites are rendered, the calls go straight through.
+// On black and white most of the saving comes from not setting what the
+// context already holds, which needs no list: 48 commands gave 6.6 color
+// sets per frame and 8 give 7.1, so aplite keeps a short list and flushes it
+// often.
+#ifndef BATCH_COMMANDS
+#if defined(PBL_PLATFORM_APLITE)
+#define BATCH_COMMANDS 8            // Flushed in chunks when it fills up
+#else
+#define BATCH_COMMANDS 128          // At most 255: batches link commands by byte
+#endif
+#endif
+#define BATCH_PATH_POINTS 5         // The shark's body is the largest path
+#define BATCH_PATH_EXTENT 255       // Recorded path points are bytes from the bounds' origin
+#define BATCH_GROUP_SCAN 8          // Batches a command looks back through for its state
+#define BATCH_PAD 1                 // Slack around each command for anti-aliasing
+
+typedef enum {
+    BATCH_FILL_CIRCLE,
+    BATCH_FILL_RECT,
+    BATCH_FILL_PATH,
+    BATCH_DRAW_LINE,
+    BATCH_DRAW_CIRCLE,
+    BATCH_DRAW_SPRITE,
+    BATCH_FRAMEBUFFER_FILL_CIRCLE,  // Direct framebuffer kernels
+    BATCH_FRAMEBUFFER_DRAW_CIRCLE,
+} BatchOp;
+
+// The part of the context state a command depends on
+typedef enum {
+    BATCH_STATE_FILL,               // Fill color
+    BATCH_STATE_STROKE,             // Stroke color and width
+    BATCH_STATE_BITMAP,             // Compositing mode
+    BATCH_STATE_FRAMEBUFFER,        // None; the kernels take their color
+} BatchState;
+
+typedef struct {
+    uint8_t op;                     // BatchOp
+    uint8_t mode;                   // Stroke width or compositing mode
+    GColor color;                   // Fill or stroke color, whichever the op uses
+    uint8_t count;                  // Path points
+    GRect bounds;                   // Every pixel the command can touch
+    union {                         // No pointers, so it's 22 bytes on the watch and host alike
+        struct { GPoint center; uint16_t radius; } circle;
+        struct { GRect rect; uint8_t corner_radius; uint8_t corners; } rect;
+        struct { GPoint from; GPoint to; } line;
+        struct { uint8_t index; bool mask; GPoint origin; } sprite;
+        uint8_t points[BATCH_PATH_POINTS][2];  // x and y past bounds.origin
+    } shape;
+} BatchCommand;
+
+typedef struct {
+    GColor fill_color;
+    GColor stroke_color;
+    uint8_t stroke_width;
+    GCompOp compositing_mode;
+} BatchContextState;
+
+// Bits of s_batch_known
+#define BATCH_KNOWN_FILL 0x01
+#define BATCH_KNOWN_STROKE 0x02
+#define BATCH_KNOWN_WIDTH 0x04
+#define BATCH_KNOWN_COMPOSITING 0x08
+
+static BatchCommand s_batch_commands[BATCH_COMMANDS];
+static int s_batch_count;
+static bool s_batch_recording;             // Between batch_begin and batch_end
+static BatchContextState s_batch_pending;  // State the draw routines have asked for
+static BatchContextState s_batch_applied;  // State the context holds, where known
+static uint8_t s_batch_known;              // Which parts of s_batch_applied are valid
+static GPath *s_batch_path = NULL;         // Replays recorded paths
+static GPoint s_batch_path_points[BATCH_PATH_POINTS];
+
+static void framebuffer_release(GContext *ctx);
+static void batch_run(GContext *ctx, const BatchCommand *command);
+static void batch_flush(GContext *ctx);
+
+// Pixels from min to max inclusive, padded on every side
+static GRect batch_bounds(int min_x, int min_y, int max_x, int max_y, int pad) {
+    return GRect(min_x - pad, min_y - pad, max_x - min_x + 1 + 2 * pad, max_y - min_y + 1 + 2 * pad);
+}
+
+// Record a command, or draw it right away outside a repaint
+static void batch_add(GContext *ctx, const BatchCommand *command) {
+    if (!s_batch_recording) {
+        batch_run(ctx, command);
+        return;
+    }
+    if (s_batch_count == BATCH_COMMANDS) batch_flush(ctx);  // Draw what's there and carry on
+    s_batch_commands[s_batch_count++] = *command;
+}
+
+static void batch_set_fill_color(GContext *ctx, GColor color) {
+    if (s_batch_recording) {
+        s_batch_pending.fill_color = color;
+    } else {
+        graphics_context_set_fill_color(ctx, color);
+    }
+}
+
+static void batch_set_stroke_color(GContext *ctx, GColor color) {
+    if (s_batch_recording) {
+        s_batch_pending.stroke_color = color;
+    } else {
+        graphics_context_set_stroke_color(ctx, color);
+    }
+}
+
+static void batch_set_stroke_width(GContext *ctx, uint8_t width) {
+    if (s_batch_recording) {
+        s_batch_pending.stroke_width = width;
+    } else {
+        graphics_context_set_stroke_width(ctx, width);
+    }
+}
+
+static void batch_set_compositing_mode(GContext *ctx, GCompOp mode) {
+    if (s_batch_recording) {
+        s_batch_pending.compositing_mode = mode;
+    } else {
+        graphics_context_set_compositing_mode(ctx, mode);
+    }
+}
+
+static void batch_fill_circle(GContext *ctx, GPoint center, uint16_t radius) {
+    BatchCommand command = {
+        .op = BATCH_FILL_CIRCLE,
+        .color = s_batch_pending.fill_color,
+        .bounds = batch_bounds(center.x - radius, center.y - radius,
+                               center.x + radius, center.y + radius, BATCH_PAD),
+        .shape.circle = { center, radius },
+    };
+    batch_add(ctx, &command);
+}
+
+static void batch_fill_rect(GContext *ctx, GRect rect, uint8_t corner_radius, GCornerMask corners) {
+    BatchCommand command = {
+        .op = BATCH_FILL_RECT,
+        .color = s_batch_pending.fill_color,
+        .bounds = batch_bounds(rect.origin.x, rect.origin.y, rect.origin.x + rect.size.w - 1,
+                               rect.origin.y + rect.size.h - 1, BATCH_PAD),
+        .shape.rect = { rect, corner_radius, (uint8_t)corners },
+    };
+    batch_add(ctx, &command);
+}
+
+// Fill a path in the current fill color. Recorded paths are copied with
+// their offset applied; none of them is rotated.
+static void batch_fill_path(GContext *ctx, GPath *path) {
+    if (!path) return;
+    if (s_batch_recording && path->num_points <= BATCH_PATH_POINTS) {
+        int min_x = INT16_MAX, min_y = INT16_MAX, max_x = INT16_MIN, max_y = INT16_MIN;
+        for (uint32_t i = 0; i < path->num_points; i++) {
+            int x = path->points[i].x + path->offset.x;
+            int y = path->points[i].y + path->offset.y;
+            if (x < min_x) min_x = x;
+            if (y < min_y) min_y = y;
+            if (x > max_x) max_x = x;
+            if (y > max_y) max_y = y;
+        }
+        
+        BatchCommand command = {
+            .op = BATCH_FILL_PATH,
+            .color = s_batch_pending.fill_color,
+            .count = path->num_points,
+            .bounds = batch_bounds(min_x, min_y, max_x, max_y, BATCH_PAD),
+        };
+        if (command.bounds.size.w <= BATCH_PATH_EXTENT && command.bounds.size.h <= BATCH_PATH_EXTENT) {
+            for (uint32_t i = 0; i < path->num_points; i++) {
+                command.shape.points[i][0] = path->points[i].x + path->offset.x - command.bounds.origin.x;
+                command.shape.points[i][1] = path->points[i].y + path->offset.y - command.bounds.origin.y;
+            }
+            batch_add(ctx, &command);
+            return;
+        }
+    }
     
-    // Fish body - using GPoint directly as required by Diorite
-    graphics_fill_circle(ctx, fish->pos, size);
+    if (s_batch_recording) {
+        // Too big to record: draw everything before it, then it
+        batch_flush(ctx);
+        graphics_context_set_fill_color(ctx, s_batch_pending.fill_color);
+        s_batch_known &= ~BATCH_KNOWN_FILL;
+    }
+    framebuffer_release(ctx);
+    gpath_draw_filled(ctx, path);
+}
+
+static void batch_draw_line(GContext *ctx, GPoint from, GPoint to) {
+    int pad = (s_batch_pending.stroke_width + 1) / 2 + BATCH_PAD;
+    BatchCommand command = {
+        .op = BATCH_DRAW_LINE,
+        .mode = s_batch_pending.stroke_width,
+        .color = s_batch_pending.stroke_color,
+        .bounds = batch_bounds(from.x < to.x ? from.x : to.x, from.y < to.y ? from.y : to.y,
+                               from.x > to.x ? from.x : to.x, from.y > to.y ? from.y : to.y, pad),
+        .shape.line = { from, to },
+    };
+    batch_add(ctx, &command);
+}
+
+static void batch_draw_circle(GContext *ctx, GPoint center, uint16_t radius) {
+    int pad = (s_batch_pending.stroke_width + 1) / 2 + BATCH_PAD;
+    BatchCommand command = {
+        .op = BATCH_DRAW_CIRCLE,
+        .mode = s_batch_pending.stroke_width,
+        .color = s_batch_pending.stroke_color,
+        .bounds = batch_bounds(center.x - radius, center.y - radius,
+                               center.x + radius, center.y + radius, pad),
+        .shape.circle = { center, radius },
+    };
+    batch_add(ctx, &command);
+}
+
+// Blit a cached pose's image, or its mask, with its top left corner at rect's
+static void batch_draw_sprite(GContext *ctx, int sprite, bool mask, GRect rect) {
+    BatchCommand command = {
+        .op = BATCH_DRAW_SPRITE,
+        .mode = s_batch_pending.compositing_mode,
+        .bounds = batch_bounds(rect.origin.x, rect.origin.y, rect.origin.x + rect.size.w - 1,
+                               rect.origin.y + rect.size.h - 1, BATCH_PAD),
+        .shape.sprite = { sprite, mask, rect.origin },
+    };
+    batch_add(ctx, &command);
+}
+
+// Direct framebuffer kernels; they take their color rather than the context's
+static void batch_framebuffer_fill_circle(GContext *ctx, GPoint center, uint16_t radius, GColor color) {
+    BatchCommand command = {
+        .op = BATCH_FRAMEBUFFER_FILL_CIRCLE,
+        .color = color,
+        .bounds = batch_bounds(center.x - radius, center.y - radius,
+                               center.x + radius, center.y + radius, BATCH_PAD),
+        .shape.circle = { center, radius },
+    };
+    batch_add(ctx, &command);
+}
+
+static void batch_framebuffer_draw_circle(GContext *ctx, GPoint center, uint16_t radius, GColor color) {
+    BatchCommand command = {
+        .op = BATCH_FRAMEBUFFER_DRAW_CIRCLE,
+        .color = color,
+        .bounds = batch_bounds(center.x - radius, center.y - radius,
+                               center.x + radius, center.y + radius, BATCH_PAD),
+        .shape.circle = { center, radius },
+    };
+    batch_add(ctx, &command);
+}
+
+// Body radius; big fish are almost twice the size
+static int fish_radius(int id) {
+    return fish_is_big(id) ? 7 : 4;
+}
+
+// Draw the tail triangle behind the body in the current fill color
+static void draw_fish_tail(GContext *ctx, int id) {
+    int size = fish_radius(id);
+    GPoint pos = entity_pos(id);
+    int direction = entity_direction(id);
     
-    // Tail
-    s_fish_tail_points[0].x = fish->pos.x - (fish->direction * size);
-    s_fish_tail_points[0].y = fish->pos.y;
-    s_fish_tail_points[1].x = fish->pos.x - (fish->direction * (size * 2));
-    s_fish_tail_points[1].y = fish->pos.y - size;
-    s_fish_tail_points[2].x = fish->pos.x - (fish->direction * (size * 2));
-    s_fish_tail_points[2].y = fish->pos.y + size;
+    s_fish_tail_points[0].x = pos.x - (direction * size);
+    s_fish_tail_points[0].y = pos.y;
+    s_fish_tail_points[1].x = pos.x - (direction * (size * 2));
+    s_fish_tail_points[1].y = pos.y - size;
+    s_fish_tail_points[2].x = pos.x - (direction * (size * 2));
+    s_fish_tail_points[2].y = pos.y + size;
     
     // Update path points WITHOUT destroying and recreating
     if (s_fish_tail_path) {
         gpath_move_to(s_fish_tail_path, GPoint(0, 0));
-        gpath_draw_filled(ctx, s_fish_tail_path);
+        batch_fill_path(ctx, s_fish_tail_path);
     }
+}
+
+// Draw fish with safety check
+static void draw_fish(GContext *ctx, int id) {
+    if (!entity_active(id)) return;
+    
+    // Set fill color (white for B&W displays)
+    batch_set_fill_color(ctx, GColorWhite);
+    
+    int size = fish_radius(id);
+    GPoint pos = entity_pos(id);
+    
+    // Fish body - using GPoint directly as required by Diorite
+    batch_fill_circle(ctx, pos, size);
+    
+    draw_fish_tail(ctx, id);
     
     // Add eye for big fish
-    if (fish->size > 1) {
-        graphics_context_set_fill_color(ctx, GColorBlack);
+    if (fish_is_big(id)) {
+        batch_set_fill_color(ctx, GColorBlack);
         GPoint eye_pos = (GPoint){
-            fish->pos.x + (fish->direction * 3),
-            fish->pos.y - 2
+            pos.x + (entity_direction(id) * 3),
+            pos.y - 2
         };
-        graphics_fill_circle(ctx, eye_pos, 1);
+        batch_fill_circle(ctx, eye_pos, 1);
+    }
+}
+
+// Seaweed sway table
+// A segment's sideways offset is sin(angle) * speed rounded toward zero, so
+// for each speed it only takes a few values, each over one stretch of the
+// cycle. The stretches are found once at load; after that a segment's offset
+// is a search through a handful of steps instead of a sin_lookup.
+#define SEAWEED_MAX_SPEED 2        // Seaweed speeds are 1 or 2
+#define SWAY_MAX_STEPS 16          // 4 * SEAWEED_MAX_SPEED + 1 are needed
+#define SWAY_QUARTER (TRIG_MAX_ANGLE / 4)
+
+typedef struct {
+    uint16_t start;                 // First angle of the stretch
+    int8_t sway;                    // Offset over it
+} SwayStep;
+
+static SwayStep s_sway_steps[SEAWEED_MAX_SPEED][SWAY_MAX_STEPS];
+static uint8_t s_sway_step_counts[SEAWEED_MAX_SPEED];
+
+// First angle of the rising quarter wave where sin * speed reaches level
+static int32_t sway_threshold(int speed, int level) {
+    int32_t low = 0;
+    int32_t high = SWAY_QUARTER;
+    while (low < high) {
+        int32_t mid = (low + high) / 2;
+        if (sin_lookup(mid) * speed >= level * TRIG_MAX_RATIO) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+// Append a stretch, folding it into the last one where nothing changes
+static void sway_step_add(int speed, int32_t start, int8_t sway) {
+    SwayStep *steps = s_sway_steps[speed - 1];
+    uint8_t *count = &s_sway_step_counts[speed - 1];
+    if (*count > 0 && steps[*count - 1].start == start) (*count)--;
+    if (*count > 0 && steps[*count - 1].sway == sway) return;
+    if (*count == SWAY_MAX_STEPS) return;  // Can't happen for these speeds
+    steps[*count] = (SwayStep){ .start = start, .sway = sway };
+    (*count)++;
+}
+
+// Only the level crossings of the rising quarter are searched for, 15
+// lookups each; sin mirrors them about the quarter and negates them over
+// the second half of the cycle.
+static void sway_table_build(void) {
+    if (s_sway_step_counts[0]) return;
+    
+    for (int speed = 1; speed <= SEAWEED_MAX_SPEED; speed++) {
+        int32_t rise[SEAWEED_MAX_SPEED + 1];
+        for (int level = 1; level <= speed; level++) {
+            rise[level] = sway_threshold(speed, level);
+        }
+        
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            int32_t half = sign > 0 ? 0 : 2 * SWAY_QUARTER;
+            sway_step_add(speed, half, 0);
+            for (int level = 1; level <= speed; level++) {
+                sway_step_add(speed, half + rise[level], sign * level);
+            }
+            for (int level = speed; level >= 1; level--) {
+                sway_step_add(speed, half + 2 * SWAY_QUARTER - rise[level] + 1, sign * (level - 1));
+            }
+        }
+    }
+}
+
+// Sideways offset of each seaweed segment for the current sway phase
+static void seaweed_sway(int id, int8_t sway[SEAWEED_SEGMENTS]) {
+    int speed = entity_speed(id);
+    if (speed < 1) speed = 1;
+    if (speed > SEAWEED_MAX_SPEED) speed = SEAWEED_MAX_SPEED;
+    const SwayStep *steps = s_sway_steps[speed - 1];
+    int last = s_sway_step_counts[speed - 1] - 1;
+    
+    for (int i = 0; i < SEAWEED_SEGMENTS; i++) {
+        int32_t angle = (s_entities.phase[id] + (i * 1000)) % TRIG_MAX_ANGLE;
+        int step = last;
+        while (step > 0 && steps[step].start > angle) step--;
+        sway[i] = steps[step].sway;
     }
 }
 
 // Draw seaweed
-static void draw_seaweed(GContext *ctx, const Seaweed *seaweed) {
+static void draw_seaweed(GContext *ctx, int id) {
     // Set stroke color (white for B&W displays)
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    graphics_context_set_stroke_width(ctx, 2);
+    batch_set_stroke_color(ctx, GColorWhite);
+    batch_set_stroke_width(ctx, 2);
     
-    GPoint current = seaweed->base;
+    GPoint current = entity_pos(id);
     GPoint next;
+    int8_t sway[SEAWEED_SEGMENTS];
+    seaweed_sway(id, sway);
     
-    for (int i = 0; i < 6; i++) {
-        int32_t angle = (seaweed->offset + (i * 1000)) % TRIG_MAX_ANGLE;
-        int16_t offset = (sin_lookup(angle) * seaweed->speed) / TRIG_MAX_RATIO;
-        
+    for (int i = 0; i < SEAWEED_SEGMENTS; i++) {
         // Properly initialize next point
-        next.x = current.x + offset;
-        next.y = current.y - 10;
+        next.x = current.x + sway[i];
+        next.y = current.y - SEAWEED_SEGMENT_LENGTH;
         
-        graphics_draw_line(ctx, current, next);
+        batch_draw_line(ctx, current, next);
         current = next;
     }
 }
 
 // Draw bubbles with safety check
-static void draw_bubble(GContext *ctx, const Bubble *bubble) {
-    if (!bubble || !bubble->active) return;
+static void draw_bubble(GContext *ctx, int id) {
+    if (!entity_active(id)) return;
     
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    graphics_draw_circle(ctx, bubble->pos, bubble->size);
+    batch_set_stroke_color(ctx, GColorWhite);
+    batch_set_stroke_width(ctx, 1);
+    batch_draw_circle(ctx, entity_pos(id), entity_size(id));
 }
 
 // Draw plankton with safety check
-static void draw_plankton(GContext *ctx, const Plankton *plankton) {
-    if (!plankton || !plankton->active) return;
+static void draw_plankton(GContext *ctx, int id) {
+    if (!entity_active(id)) return;
     
-    graphics_context_set_fill_color(ctx, GColorWhite);
+    batch_set_fill_color(ctx, GColorWhite);
     
     // Draw as a tiny dot/small shape
-    graphics_fill_circle(ctx, plankton->pos, 1);
+    batch_fill_circle(ctx, entity_pos(id), 1);
 }
 
-// Draw octopus
-static void draw_octopus(GContext *ctx, const Octopus *octopus) {
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    
-    // Draw head
-    graphics_fill_circle(ctx, octopus->pos, 6);
-    
-    // Draw eyes
-    graphics_context_set_fill_color(ctx, GColorBlack);
-    GPoint left_eye = (GPoint){octopus->pos.x - 2, octopus->pos.y - 2};
-    GPoint right_eye = (GPoint){octopus->pos.x + 2, octopus->pos.y - 2};
-    graphics_fill_circle(ctx, left_eye, 1);
-    graphics_fill_circle(ctx, right_eye, 1);
-    
-    // Draw tentacles
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    
-    for (int i = 0; i < 8; i++) {
-        int32_t angle = (octopus->tentacle_offset + (i * TRIG_MAX_ANGLE / 8)) % TRIG_MAX_ANGLE;
+// Tentacle pose cache
+// Octopus and jellyfish tentacles are chains of short segments whose angles
+// ripple with the creature's phase, which costs three trig lookups per
+// octopus segment. A pose depends on nothing but the phase, so it's worked
+// out relative to the body once and kept in a small ring shared by every
+// tentacled creature, and drawing only translates it. Each distinct phase
+// is posed once, however many times it's drawn.
+#define TENTACLE_CACHE_SIZE 4           // An octopus and a few jellyfish
+
+#define OCTOPUS_TENTACLES 8
+#define JELLYFISH_TENTACLES 5
+#define TENTACLE_SEGMENTS 3
+#define TENTACLE_MAX_POINTS (OCTOPUS_TENTACLES * TENTACLE_SEGMENTS)
+
+typedef struct {
+    bool valid;
+    bool octopus;                       // Octopus or jellyfish pose
+    uint16_t phase;                     // Phase it was posed for
+    int8_t x[TENTACLE_MAX_POINTS];      // Segment ends, tentacle by tentacle;
+    int8_t y[TENTACLE_MAX_POINTS];      // relative to where the tentacle starts
+} TentaclePose;
+
+static TentaclePose s_tentacle_poses[TENTACLE_CACHE_SIZE];
+static uint8_t s_tentacle_next;         // Ring slot to reuse next
+
+// Octopus tentacles fan out from the middle of the head
+static void octopus_pose(uint16_t tentacle_offset, TentaclePose *pose) {
+    for (int i = 0; i < OCTOPUS_TENTACLES; i++) {
+        int32_t angle = (tentacle_offset + (i * TRIG_MAX_ANGLE / 8)) % TRIG_MAX_ANGLE;
         int distance = 8;
+        int x = 0, y = 0;
         
-        GPoint start = octopus->pos;
-        GPoint end;
-        
-        for (int j = 0; j < 3; j++) {
-            int32_t wave_angle = (octopus->tentacle_offset * 3 + (i * 500) + (j * 2000)) % TRIG_MAX_ANGLE;
+        for (int j = 0; j < TENTACLE_SEGMENTS; j++) {
+            int32_t wave_angle = (tentacle_offset * 3 + (i * 500) + (j * 2000)) % TRIG_MAX_ANGLE;
             int16_t wave_offset = (sin_lookup(wave_angle) * 3) / TRIG_MAX_RATIO;
             
             int32_t segment_angle = angle + (wave_offset * TRIG_MAX_ANGLE / 360);
             
-            end.x = start.x + (sin_lookup(segment_angle) * distance) / TRIG_MAX_RATIO;
-            end.y = start.y + (cos_lookup(segment_angle) * distance) / TRIG_MAX_RATIO;
-            
-            graphics_draw_line(ctx, start, end);
-            start = end;
+            x += (sin_lookup(segment_angle) * distance) / TRIG_MAX_RATIO;
+            y += (cos_lookup(segment_angle) * distance) / TRIG_MAX_RATIO;
+            pose->x[i * TENTACLE_SEGMENTS + j] = x;
+            pose->y[i * TENTACLE_SEGMENTS + j] = y;
             distance = j < 2 ? 6 : 4;  // Get shorter toward the end
         }
     }
 }
 
+// Jellyfish tentacles hang from the rim of the bell, swaying sideways
+static void jellyfish_pose(uint16_t phase, TentaclePose *pose) {
+    for (int i = 0; i < JELLYFISH_TENTACLES; i++) {
+        int x = 0;
+        for (int j = 0; j < TENTACLE_SEGMENTS; j++) {
+            int32_t wave_angle = (phase + (i * 1000) + (j * 1500)) % TRIG_MAX_ANGLE;
+            x += (sin_lookup(wave_angle) * 3) / TRIG_MAX_RATIO;
+            pose->x[i * TENTACLE_SEGMENTS + j] = x;
+            pose->y[i * TENTACLE_SEGMENTS + j] = 5 * (j + 1);
+        }
+    }
+}
+
+static const TentaclePose *tentacle_pose(bool octopus, uint16_t phase) {
+    for (int i = 0; i < TENTACLE_CACHE_SIZE; i++) {
+        TentaclePose *pose = &s_tentacle_poses[i];
+        if (pose->valid && pose->octopus == octopus && pose->phase == phase) return pose;
+    }
+    
+    TentaclePose *pose = &s_tentacle_poses[s_tentacle_next];
+    s_tentacle_next = (s_tentacle_next + 1) % TENTACLE_CACHE_SIZE;
+    if (octopus) {
+        octopus_pose(phase, pose);
+    } else {
+        jellyfish_pose(phase, pose);
+    }
+    pose->valid = true;
+    pose->octopus = octopus;
+    pose->phase = phase;
+    return pose;
+}
+
+// Draw a tentacle's segments from start, as a pose lays them out
+static void draw_tentacle(GContext *ctx, const TentaclePose *pose, int tentacle, GPoint start) {
+    GPoint current = start;
+    for (int j = 0; j < TENTACLE_SEGMENTS; j++) {
+        int k = tentacle * TENTACLE_SEGMENTS + j;
+        GPoint next = GPoint(start.x + pose->x[k], start.y + pose->y[k]);
+        batch_draw_line(ctx, current, next);
+        current = next;
+    }
+}
+
+// Draw octopus
+static void draw_octopus(GContext *ctx) {
+    GPoint pos = entity_pos(ENTITY_OCTOPUS);
+    
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
+    
+    // Draw head
+    batch_fill_circle(ctx, pos, 6);
+    
+    // Draw eyes
+    batch_set_fill_color(ctx, GColorBlack);
+    GPoint left_eye = (GPoint){pos.x - 2, pos.y - 2};
+    GPoint right_eye = (GPoint){pos.x + 2, pos.y - 2};
+    batch_fill_circle(ctx, left_eye, 1);
+    batch_fill_circle(ctx, right_eye, 1);
+    
+    // Draw tentacles
+    batch_set_stroke_color(ctx, GColorWhite);
+    batch_set_stroke_width(ctx, 1);
+    batch_set_fill_color(ctx, GColorWhite);
+    
+    const TentaclePose *pose = tentacle_pose(true, s_entities.phase[ENTITY_OCTOPUS]);
+    for (int i = 0; i < OCTOPUS_TENTACLES; i++) {
+        draw_tentacle(ctx, pose, i, pos);
+    }
+}
+
 // Draw shark with safety check
-static void draw_shark(GContext *ctx, const Shark *shark) {
-    if (!shark || !shark->active) return;
+static void draw_shark(GContext *ctx) {
+    if (!entity_active(ENTITY_SHARK)) return;
+    
+    GPoint pos = entity_pos(ENTITY_SHARK);
+    int direction = entity_direction(ENTITY_SHARK);
     
     // Simple, classic shark design
-    graphics_context_set_fill_color(ctx, GColorWhite);
+    batch_set_fill_color(ctx, GColorWhite);
     
     // Update shark body points
-    s_shark_body_points[0].x = shark->pos.x + (shark->direction * 15);
-    s_shark_body_points[0].y = shark->pos.y;        // nose
-    s_shark_body_points[1].x = shark->pos.x;
-    s_shark_body_points[1].y = shark->pos.y - 8;    // top of body
-    s_shark_body_points[2].x = shark->pos.x - (shark->direction * 15);
-    s_shark_body_points[2].y = shark->pos.y - 5;    // back top
-    s_shark_body_points[3].x = shark->pos.x - (shark->direction * 15);
-    s_shark_body_points[3].y = shark->pos.y + 5;    // back bottom
-    s_shark_body_points[4].x = shark->pos.x;
-    s_shark_body_points[4].y = shark->pos.y + 8;    // bottom of body
+    s_shark_body_points[0].x = pos.x + (direction * 15);
+    s_shark_body_points[0].y = pos.y;        // nose
+    s_shark_body_points[1].x = pos.x;
+    s_shark_body_points[1].y = pos.y - 8;    // top of body
+    s_shark_body_points[2].x = pos.x - (direction * 15);
+    s_shark_body_points[2].y = pos.y - 5;    // back top
+    s_shark_body_points[3].x = pos.x - (direction * 15);
+    s_shark_body_points[3].y = pos.y + 5;    // back bottom
+    s_shark_body_points[4].x = pos.x;
+    s_shark_body_points[4].y = pos.y + 8;    // bottom of body
     
     // Update path WITHOUT destroying and recreating
     if (s_shark_body_path) {
         gpath_move_to(s_shark_body_path, GPoint(0, 0));
-        gpath_draw_filled(ctx, s_shark_body_path);
+        batch_fill_path(ctx, s_shark_body_path);
     }
     
     // Update tail points
-    s_shark_tail_points[0].x = shark->pos.x - (shark->direction * 15);
-    s_shark_tail_points[0].y = shark->pos.y - 5;
-    s_shark_tail_points[1].x = shark->pos.x - (shark->direction * 15);
-    s_shark_tail_points[1].y = shark->pos.y + 5;
-    s_shark_tail_points[2].x = shark->pos.x - (shark->direction * 25);
-    s_shark_tail_points[2].y = shark->pos.y;
+    s_shark_tail_points[0].x = pos.x - (direction * 15);
+    s_shark_tail_points[0].y = pos.y - 5;
+    s_shark_tail_points[1].x = pos.x - (direction * 15);
+    s_shark_tail_points[1].y = pos.y + 5;
+    s_shark_tail_points[2].x = pos.x - (direction * 25);
+    s_shark_tail_points[2].y = pos.y;
     
     // Update path WITHOUT destroying and recreating
     if (s_shark_tail_path) {
         gpath_move_to(s_shark_tail_path, GPoint(0, 0));
-        gpath_draw_filled(ctx, s_shark_tail_path);
+        batch_fill_path(ctx, s_shark_tail_path);
     }
     
     // Update fin points
-    s_shark_fin_points[0].x = shark->pos.x - (shark->direction * 5);
-    s_shark_fin_points[0].y = shark->pos.y - 8;
-    s_shark_fin_points[1].x = shark->pos.x - (shark->direction * 5);
-    s_shark_fin_points[1].y = shark->pos.y - 16;
-    s_shark_fin_points[2].x = shark->pos.x + (shark->direction * 3);
-    s_shark_fin_points[2].y = shark->pos.y - 8;
+    s_shark_fin_points[0].x = pos.x - (direction * 5);
+    s_shark_fin_points[0].y = pos.y - 8;
+    s_shark_fin_points[1].x = pos.x - (direction * 5);
+    s_shark_fin_points[1].y = pos.y - 16;
+    s_shark_fin_points[2].x = pos.x + (direction * 3);
+    s_shark_fin_points[2].y = pos.y - 8;
     
     // Update path WITHOUT destroying and recreating
     if (s_shark_fin_path) {
         gpath_move_to(s_shark_fin_path, GPoint(0, 0));
-        gpath_draw_filled(ctx, s_shark_fin_path);
+        batch_fill_path(ctx, s_shark_fin_path);
     }
     
     // Draw eye
-    graphics_context_set_fill_color(ctx, GColorBlack);
+    batch_set_fill_color(ctx, GColorBlack);
     GPoint eye_pos = (GPoint){
-        shark->pos.x + (shark->direction * 8),
-        shark->pos.y - 2
+        pos.x + (direction * 8),
+        pos.y - 2
     };
-    graphics_fill_circle(ctx, eye_pos, 1);
+    batch_fill_circle(ctx, eye_pos, 1);
     
     // Simple mouth line
-    graphics_context_set_stroke_color(ctx, GColorBlack);
-    graphics_context_set_stroke_width(ctx, 1);
-    graphics_draw_line(ctx, 
-                       (GPoint){shark->pos.x + (shark->direction * 14), shark->pos.y + 2},
-                       (GPoint){shark->pos.x + (shark->direction * 6), shark->pos.y + 3});
+    batch_set_stroke_color(ctx, GColorBlack);
+    batch_set_stroke_width(ctx, 1);
+    batch_draw_line(ctx, 
+                       (GPoint){pos.x + (direction * 14), pos.y + 2},
+                       (GPoint){pos.x + (direction * 6), pos.y + 3});
 }
 
-// Draw turtle with safety check
-static void draw_turtle(GContext *ctx, const Turtle *turtle) {
-    if (!turtle) return;
-    
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    
-    // Animation offset for swimming motion
-    int32_t flipper_angle = turtle->animation_offset % TRIG_MAX_ANGLE;
-    int flipper_offset = (sin_lookup(flipper_angle) * 2) / TRIG_MAX_RATIO;
+// How far the flippers reach out for the current swim stroke
+static int turtle_flipper_offset(int id) {
+    int32_t flipper_angle = s_entities.phase[id] % TRIG_MAX_ANGLE;
+    return (sin_lookup(flipper_angle) * 2) / TRIG_MAX_RATIO;
+}
+
+// Draw a turtle facing direction with its flippers at flipper_offset
+static void draw_turtle_pose(GContext *ctx, GPoint pos, int direction, int flipper_offset) {
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
     
     // Draw shell with pattern (oval with details)
     GRect shell_rect = (GRect){
-        .origin = {turtle->pos.x - 8, turtle->pos.y - 5},
+        .origin = {pos.x - 8, pos.y - 5},
         .size = {16, 10}
     };
-    graphics_fill_rect(ctx, shell_rect, 4, GCornersAll);
+    batch_fill_rect(ctx, shell_rect, 4, GCornersAll);
     
     // Shell pattern - draw shell segments
-    graphics_context_set_stroke_color(ctx, GColorBlack);
-    graphics_context_set_stroke_width(ctx, 1);
+    batch_set_stroke_color(ctx, GColorBlack);
+    batch_set_stroke_width(ctx, 1);
     
     // Vertical line down the middle
-    graphics_draw_line(ctx, 
-                      (GPoint){turtle->pos.x, turtle->pos.y - 5},
-                      (GPoint){turtle->pos.x, turtle->pos.y + 5});
+    batch_draw_line(ctx, 
+                      (GPoint){pos.x, pos.y - 5},
+                      (GPoint){pos.x, pos.y + 5});
     
     // Horizontal segments
-    graphics_draw_line(ctx, 
-                      (GPoint){turtle->pos.x - 7, turtle->pos.y - 2},
-                      (GPoint){turtle->pos.x + 7, turtle->pos.y - 2});
-    graphics_draw_line(ctx, 
-                      (GPoint){turtle->pos.x - 7, turtle->pos.y + 2},
-                      (GPoint){turtle->pos.x + 7, turtle->pos.y + 2});
+    batch_draw_line(ctx, 
+                      (GPoint){pos.x - 7, pos.y - 2},
+                      (GPoint){pos.x + 7, pos.y - 2});
+    batch_draw_line(ctx, 
+                      (GPoint){pos.x - 7, pos.y + 2},
+                      (GPoint){pos.x + 7, pos.y + 2});
     
     // Draw head
-    graphics_context_set_fill_color(ctx, GColorWhite);
+    batch_set_fill_color(ctx, GColorWhite);
     GPoint head_pos = (GPoint){
-        turtle->pos.x + (turtle->direction * 9),
-        turtle->pos.y
+        pos.x + (direction * 9),
+        pos.y
     };
-    graphics_fill_circle(ctx, head_pos, 4);
+    batch_fill_circle(ctx, head_pos, 4);
     
     // Draw eye
-    graphics_context_set_fill_color(ctx, GColorBlack);
+    batch_set_fill_color(ctx, GColorBlack);
     GPoint eye_pos = (GPoint){
-        head_pos.x + (turtle->direction * 1),
+        head_pos.x + (direction * 1),
         head_pos.y - 1
     };
-    graphics_fill_circle(ctx, eye_pos, 1);
+    batch_fill_circle(ctx, eye_pos, 1);
     
     // Draw flippers
-    graphics_context_set_fill_color(ctx, GColorWhite);
+    batch_set_fill_color(ctx, GColorWhite);
     
     // Front flipper - update points
-    s_turtle_front_flipper_points[0].x = turtle->pos.x + (turtle->direction * 5);
-    s_turtle_front_flipper_points[0].y = turtle->pos.y - 2;
-    s_turtle_front_flipper_points[1].x = turtle->pos.x + (turtle->direction * 5);
-    s_turtle_front_flipper_points[1].y = turtle->pos.y + 6;
-    s_turtle_front_flipper_points[2].x = turtle->pos.x + (turtle->direction * (10 + flipper_offset));
-    s_turtle_front_flipper_points[2].y = turtle->pos.y + 5;
+    s_turtle_front_flipper_points[0].x = pos.x + (direction * 5);
+    s_turtle_front_flipper_points[0].y = pos.y - 2;
+    s_turtle_front_flipper_points[1].x = pos.x + (direction * 5);
+    s_turtle_front_flipper_points[1].y = pos.y + 6;
+    s_turtle_front_flipper_points[2].x = pos.x + (direction * (10 + flipper_offset));
+    s_turtle_front_flipper_points[2].y = pos.y + 5;
     
     // Back flipper - update points
-    s_turtle_back_flipper_points[0].x = turtle->pos.x - (turtle->direction * 5);
-    s_turtle_back_flipper_points[0].y = turtle->pos.y - 2;
-    s_turtle_back_flipper_points[1].x = turtle->pos.x - (turtle->direction * 5);
-    s_turtle_back_flipper_points[1].y = turtle->pos.y + 6;
-    s_turtle_back_flipper_points[2].x = turtle->pos.x - (turtle->direction * (10 - flipper_offset));
-    s_turtle_back_flipper_points[2].y = turtle->pos.y + 5;
+    s_turtle_back_flipper_points[0].x = pos.x - (direction * 5);
+    s_turtle_back_flipper_points[0].y = pos.y - 2;
+    s_turtle_back_flipper_points[1].x = pos.x - (direction * 5);
+    s_turtle_back_flipper_points[1].y = pos.y + 6;
+    s_turtle_back_flipper_points[2].x = pos.x - (direction * (10 - flipper_offset));
+    s_turtle_back_flipper_points[2].y = pos.y + 5;
     
     // Update and draw front flipper path WITHOUT destroying and recreating
     if (s_turtle_front_flipper_path) {
         gpath_move_to(s_turtle_front_flipper_path, GPoint(0, 0));
-        gpath_draw_filled(ctx, s_turtle_front_flipper_path);
+        batch_fill_path(ctx, s_turtle_front_flipper_path);
     }
     
     // Update and draw back flipper path WITHOUT destroying and recreating
     if (s_turtle_back_flipper_path) {
         gpath_move_to(s_turtle_back_flipper_path, GPoint(0, 0));
-        gpath_draw_filled(ctx, s_turtle_back_flipper_path);
+        batch_fill_path(ctx, s_turtle_back_flipper_path);
     }
 }
 
+// Draw turtle with safety check
+static void draw_turtle(GContext *ctx, int id) {
+    // Animation offset for swimming motion
+    draw_turtle_pose(ctx, entity_pos(id), entity_direction(id), turtle_flipper_offset(id));
+}
+
+// Bell radius for the current point in the pulse
+static int jellyfish_bell_size(int id) {
+    int pulse_state = s_jellyfish_pulse[id - ENTITY_JELLYFISH];
+    return 7 + ((pulse_state < 50) ? pulse_state / 10 : (100 - pulse_state) / 10);
+}
+
 // Draw jellyfish with safety check
-static void draw_jellyfish(GContext *ctx, const Jellyfish *jellyfish) {
-    if (!jellyfish) return;
+static void draw_jellyfish(GContext *ctx, int id) {
+    GPoint pos = entity_pos(id);
     
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
     
     // Pulsing animation for the bell
-    int bell_size = 7 + ((jellyfish->pulse_state < 50) ? jellyfish->pulse_state / 10 : (100 - jellyfish->pulse_state) / 10);
+    int bell_size = jellyfish_bell_size(id);
     
     // Draw bell (semi-circle)
     int bell_width = bell_size * 2;
     GRect bell_rect = (GRect){
-        .origin = {jellyfish->pos.x - bell_size, jellyfish->pos.y - bell_size},
+        .origin = {pos.x - bell_size, pos.y - bell_size},
         .size = {bell_width, bell_size}
     };
-    graphics_fill_rect(ctx, bell_rect, 0, GCornerNone);
-    graphics_fill_circle(ctx, (GPoint){jellyfish->pos.x, jellyfish->pos.y - bell_size}, bell_size);
+    batch_fill_rect(ctx, bell_rect, 0, GCornerNone);
+    batch_fill_circle(ctx, (GPoint){pos.x, pos.y - bell_size}, bell_size);
     
     // Draw tentacles
-    for (int i = 0; i < 5; i++) {
-        int x_pos = jellyfish->pos.x - bell_size + (i * bell_width / 4);
-        GPoint start = (GPoint){x_pos, jellyfish->pos.y};
-        GPoint end = start;
-        
-        for (int j = 0; j < 3; j++) {
-            int32_t wave_angle = (jellyfish->tentacle_offset + (i * 1000) + (j * 1500)) % TRIG_MAX_ANGLE;
-            int16_t wave_offset = (sin_lookup(wave_angle) * 3) / TRIG_MAX_RATIO;
-            
-            end.x = start.x + wave_offset;
-            end.y = start.y + 5;
-            
-            graphics_draw_line(ctx, start, end);
-            start = end;
-        }
+    batch_set_stroke_width(ctx, 1);
+    const TentaclePose *pose = tentacle_pose(false, s_entities.phase[id]);
+    for (int i = 0; i < JELLYFISH_TENTACLES; i++) {
+        int x_pos = pos.x - bell_size + (i * bell_width / 4);
+        draw_tentacle(ctx, pose, i, GPoint(x_pos, pos.y));
     }
 }
 
-// Draw crab
-static void draw_crab(GContext *ctx, const Crab *crab) {
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
+// Claws snap between two positions
+static int crab_claw_offset(void) {
+    return (s_entities.phase[ENTITY_CRAB] % 20 < 10) ? 0 : 1;
+}
+
+// Draw a crab with its claws at claw_offset
+static void draw_crab_pose(GContext *ctx, GPoint pos, int claw_offset) {
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
     
     // Draw tiny body (small circle)
-    graphics_fill_circle(ctx, crab->pos, 3);
+    batch_fill_circle(ctx, pos, 3);
     
-    // Animate claws
-    int claw_offset = (crab->claw_state % 20 < 10) ? 0 : 1;
+    // Legs and claws are 2px wide, as they were when inherited from the seaweed
+    batch_set_stroke_width(ctx, 2);
     
     // Draw legs (3 on each side)
     for (int i = 0; i < 3; i++) {
         // Left legs
-        GPoint leg_start_l = (GPoint){crab->pos.x - 2, crab->pos.y - 1 + i};
-        GPoint leg_end_l = (GPoint){crab->pos.x - 5, crab->pos.y + 1 + i};
-        graphics_draw_line(ctx, leg_start_l, leg_end_l);
+        GPoint leg_start_l = (GPoint){pos.x - 2, pos.y - 1 + i};
+        GPoint leg_end_l = (GPoint){pos.x - 5, pos.y + 1 + i};
+        batch_draw_line(ctx, leg_start_l, leg_end_l);
         
         // Right legs
-        GPoint leg_start_r = (GPoint){crab->pos.x + 2, crab->pos.y - 1 + i};
-        GPoint leg_end_r = (GPoint){crab->pos.x + 5, crab->pos.y + 1 + i};
-        graphics_draw_line(ctx, leg_start_r, leg_end_r);
+        GPoint leg_start_r = (GPoint){pos.x + 2, pos.y - 1 + i};
+        GPoint leg_end_r = (GPoint){pos.x + 5, pos.y + 1 + i};
+        batch_draw_line(ctx, leg_start_r, leg_end_r);
     }
     
     // Draw claws
-    GPoint claw_left_start = (GPoint){crab->pos.x - 3, crab->pos.y - 2};
-    GPoint claw_left_mid = (GPoint){crab->pos.x - 5, crab->pos.y - 3};
-    GPoint claw_left_end = (GPoint){crab->pos.x - 6, crab->pos.y - 4 + claw_offset};
+    GPoint claw_left_start = (GPoint){pos.x - 3, pos.y - 2};
+    GPoint claw_left_mid = (GPoint){pos.x - 5, pos.y - 3};
+    GPoint claw_left_end = (GPoint){pos.x - 6, pos.y - 4 + claw_offset};
     
-    GPoint claw_right_start = (GPoint){crab->pos.x + 3, crab->pos.y - 2};
-    GPoint claw_right_mid = (GPoint){crab->pos.x + 5, crab->pos.y - 3};
-    GPoint claw_right_end = (GPoint){crab->pos.x + 6, crab->pos.y - 4 + claw_offset};
+    GPoint claw_right_start = (GPoint){pos.x + 3, pos.y - 2};
+    GPoint claw_right_mid = (GPoint){pos.x + 5, pos.y - 3};
+    GPoint claw_right_end = (GPoint){pos.x + 6, pos.y - 4 + claw_offset};
     
-    graphics_draw_line(ctx, claw_left_start, claw_left_mid);
-    graphics_draw_line(ctx, claw_left_mid, claw_left_end);
+    batch_draw_line(ctx, claw_left_start, claw_left_mid);
+    batch_draw_line(ctx, claw_left_mid, claw_left_end);
     
-    graphics_draw_line(ctx, claw_right_start, claw_right_mid);
-    graphics_draw_line(ctx, claw_right_mid, claw_right_end);
+    batch_draw_line(ctx, claw_right_start, claw_right_mid);
+    batch_draw_line(ctx, claw_right_mid, claw_right_end);
     
     // Draw eyes (tiny dots on top)
-    graphics_context_set_fill_color(ctx, GColorBlack);
-    GPoint eye_left = (GPoint){crab->pos.x - 1, crab->pos.y - 2};
-    GPoint eye_right = (GPoint){crab->pos.x + 1, crab->pos.y - 2};
-    graphics_fill_circle(ctx, eye_left, 1);
-    graphics_fill_circle(ctx, eye_right, 1);
+    batch_set_fill_color(ctx, GColorBlack);
+    GPoint eye_left = (GPoint){pos.x - 1, pos.y - 2};
+    GPoint eye_right = (GPoint){pos.x + 1, pos.y - 2};
+    batch_fill_circle(ctx, eye_left, 1);
+    batch_fill_circle(ctx, eye_right, 1);
 }
 
-// Draw clam
-static void draw_clam(GContext *ctx, const Clam *clam) {
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
+// Draw crab
+static void draw_crab(GContext *ctx) {
+    // Animate claws
+    draw_crab_pose(ctx, entity_pos(ENTITY_CRAB), crab_claw_offset());
+}
+
+// How far the top shell is lifted
+static int clam_open_amount(void) {
+    int open_state = s_entities.phase[ENTITY_CLAM];
+    return (open_state > 0) ? open_state / 10 : 0;
+}
+
+// Draw a clam with its top shell lifted by open_amount
+static void draw_clam_pose(GContext *ctx, GPoint pos, int open_amount) {
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
     
     // Draw clam shell
-    int open_amount = (clam->open_state > 0) ? clam->open_state / 10 : 0;
-    
     // Bottom half (static)
     GRect bottom_rect = (GRect){
-        .origin = {clam->pos.x - 5, clam->pos.y - 2},
+        .origin = {pos.x - 5, pos.y - 2},
         .size = {10, 4}
     };
-    graphics_fill_rect(ctx, bottom_rect, 3, GCornersBottom);
+    batch_fill_rect(ctx, bottom_rect, 3, GCornersBottom);
     
     // Top half (moves slightly when opening)
     GRect top_rect = (GRect){
-        .origin = {clam->pos.x - 5, clam->pos.y - 4 - open_amount},
+        .origin = {pos.x - 5, pos.y - 4 - open_amount},
         .size = {10, 4}
     };
-    graphics_fill_rect(ctx, top_rect, 3, GCornersTop);
+    batch_fill_rect(ctx, top_rect, 3, GCornersTop);
     
     // If open, show a tiny pearl inside
     if (open_amount > 0) {
-        graphics_context_set_fill_color(ctx, GColorBlack);
-        GPoint pearl_pos = (GPoint){clam->pos.x, clam->pos.y - 2};
-        graphics_fill_circle(ctx, pearl_pos, 1);
+        batch_set_fill_color(ctx, GColorBlack);
+        GPoint pearl_pos = (GPoint){pos.x, pos.y - 2};
+        batch_fill_circle(ctx, pearl_pos, 1);
     }
 }
 
-// Draw seahorse
-static void draw_seahorse(GContext *ctx, const Seahorse *seahorse) {
-    if (!seahorse->active) return;
-    
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    
-    // Animate curve state for gentle swaying
-    int32_t curve_angle = seahorse->curve_state % TRIG_MAX_ANGLE;
-    int curve_offset = (sin_lookup(curve_angle) * 2) / TRIG_MAX_RATIO;
+// Draw clam
+static void draw_clam(GContext *ctx) {
+    draw_clam_pose(ctx, entity_pos(ENTITY_CLAM), clam_open_amount());
+}
+
+// Sideways bend of the body for the current sway phase
+static int seahorse_curve_offset(void) {
+    int32_t curve_angle = s_entities.phase[ENTITY_SEAHORSE] % TRIG_MAX_ANGLE;
+    return (sin_lookup(curve_angle) * 2) / TRIG_MAX_RATIO;
+}
+
+// Draw a seahorse with its body bent by curve_offset
+static void draw_seahorse_pose(GContext *ctx, GPoint pos, int curve_offset) {
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
     
     // Draw the head - positioned upright like a real seahorse
-    GPoint head_pos = seahorse->pos;
-    graphics_fill_circle(ctx, head_pos, 5); // Clear seahorse head
+    GPoint head_pos = pos;
+    batch_fill_circle(ctx, head_pos, 5); // Clear seahorse head
     
     // Draw the snout - characteristic downward-facing seahorse snout
     GPoint snout_start = (GPoint){head_pos.x, head_pos.y - 2};
     GPoint snout_mid = (GPoint){head_pos.x + 3, head_pos.y + 1};
     GPoint snout_end = (GPoint){head_pos.x + 6, head_pos.y + 3};
     
-    graphics_context_set_stroke_width(ctx, 2);
-    graphics_draw_line(ctx, snout_start, snout_mid);
-    graphics_draw_line(ctx, snout_mid, snout_end);
+    batch_set_stroke_width(ctx, 2);
+    batch_draw_line(ctx, snout_start, snout_mid);
+    batch_draw_line(ctx, snout_mid, snout_end);
     
     // Draw characteristic coronet/crest on top of head
     GPoint crest[3] = {
@@ -692,20 +1484,20 @@ static void draw_seahorse(GContext *ctx, const Seahorse *seahorse) {
         {head_pos.x, head_pos.y - 8},
         {head_pos.x + 2, head_pos.y - 5}
     };
-    graphics_context_set_stroke_width(ctx, 1);
+    batch_set_stroke_width(ctx, 1);
     for (int i = 0; i < 2; i++) {
-        graphics_draw_line(ctx, crest[i], crest[i+1]);
+        batch_draw_line(ctx, crest[i], crest[i+1]);
     }
     
     // Draw eye
-    graphics_context_set_fill_color(ctx, GColorBlack);
+    batch_set_fill_color(ctx, GColorBlack);
     GPoint eye_pos = (GPoint){head_pos.x + 2, head_pos.y - 1};
-    graphics_fill_circle(ctx, eye_pos, 1);
+    batch_fill_circle(ctx, eye_pos, 1);
     
     // Draw the main body - more pronounced curve with segments
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    graphics_context_set_stroke_color(ctx, GColorWhite);
-    graphics_context_set_stroke_width(ctx, 3);
+    batch_set_fill_color(ctx, GColorWhite);
+    batch_set_stroke_color(ctx, GColorWhite);
+    batch_set_stroke_width(ctx, 3);
     
     // Set up body segments for a better seahorse curve
     // Seahorses have a distinctive curved body that arches forward
@@ -733,11 +1525,11 @@ static void draw_seahorse(GContext *ctx, const Seahorse *seahorse) {
     
     // Draw the body segments
     for (int i = 1; i < 7; i++) {
-        graphics_draw_line(ctx, body_segments[i-1], body_segments[i]);
+        batch_draw_line(ctx, body_segments[i-1], body_segments[i]);
     }
     
     // Draw the characteristic segmented appearance
-    graphics_context_set_stroke_width(ctx, 1);
+    batch_set_stroke_width(ctx, 1);
     for (int i = 1; i < 6; i++) {
         // Draw little ridges/bumps along the outer edge
         GPoint bump1 = {
@@ -748,167 +1540,1316 @@ static void draw_seahorse(GContext *ctx, const Seahorse *seahorse) {
             body_segments[i].x + 3,
             body_segments[i].y
         };
-        graphics_draw_line(ctx, body_segments[i], bump1);
-        graphics_draw_line(ctx, bump1, bump2);
+        batch_draw_line(ctx, body_segments[i], bump1);
+        batch_draw_line(ctx, bump1, bump2);
+    }
+    
+    // Draw the curled tail - tightly curled at the end
+    GPoint tail_points[4];
+    tail_points[0] = body_segments[6];
+    tail_points[1].x = body_segments[6].x - 2;
+    tail_points[1].y = body_segments[6].y + 3;
+    tail_points[2].x = body_segments[6].x - 4;
+    tail_points[2].y = body_segments[6].y + 2;
+    tail_points[3].x = body_segments[6].x - 5;
+    tail_points[3].y = body_segments[6].y - 1;
+    
+    batch_set_stroke_width(ctx, 2);
+    for (int i = 1; i < 4; i++) {
+        batch_draw_line(ctx, tail_points[i-1], tail_points[i]);
+    }
+    
+    // Draw the characteristic bulging belly - seahorses have a distinct pouch
+    batch_set_fill_color(ctx, GColorWhite);
+    GPoint belly_center = (GPoint){
+        body_segments[3].x - 4,
+        body_segments[3].y
+    };
+    batch_fill_circle(ctx, belly_center, 3);
+    
+    // Draw dorsal fin - on the back
+    batch_set_stroke_width(ctx, 1);
+    GPoint dorsal_fin[3] = {
+        {body_segments[2].x, body_segments[2].y},
+        {body_segments[2].x - 4, body_segments[2].y - 5},
+        {body_segments[2].x + 2, body_segments[2].y - 2}
+    };
+    
+    for (int i = 0; i < 2; i++) {
+        batch_draw_line(ctx, dorsal_fin[i], dorsal_fin[i+1]);
+    }
+    
+    // Draw pectoral fin - small fin behind head
+    GPoint pectoral_fin[3] = {
+        {body_segments[1].x, body_segments[1].y},
+        {body_segments[1].x - 3, body_segments[1].y - 2},
+        {body_segments[1].x - 1, body_segments[1].y + 2}
+    };
+    
+    for (int i = 0; i < 2; i++) {
+        batch_draw_line(ctx, pectoral_fin[i], pectoral_fin[i+1]);
+    }
+}
+
+// Draw seahorse
+static void draw_seahorse(GContext *ctx) {
+    if (!entity_active(ENTITY_SEAHORSE)) return;
+    
+    // Animate curve state for gentle swaying
+    draw_seahorse_pose(ctx, entity_pos(ENTITY_SEAHORSE), seahorse_curve_offset());
+}
+
+// Check if two elements collide (basic circle collision)
+static bool check_collision(GPoint pos1, int radius1, GPoint pos2, int radius2) {
+    int dx = pos1.x - pos2.x;
+    int dy = pos1.y - pos2.y;
+    int distance_squared = (dx * dx) + (dy * dy);
+    int radius_sum = radius1 + radius2;
+    return distance_squared <= (radius_sum * radius_sum);
+}
+
+// Calculate grid cell for a point
+static int get_grid_cell(GPoint point) {
+    // Ensure point is within bounds before calculating cell
+    if (point.x < 0) point.x = 0;
+    if (point.x >= s_scene.width) point.x = s_scene.width - 1;
+    if (point.y < 0) point.y = 0;
+    if (point.y >= s_scene.height) point.y = s_scene.height - 1;
+    
+    int grid_x = point.x / s_scene.grid_cell_width;
+    int grid_y = point.y / s_scene.grid_cell_height;
+    
+    // Extra bounds check to guarantee valid result
+    if (grid_x < 0) grid_x = 0;
+    if (grid_x >= GRID_WIDTH) grid_x = GRID_WIDTH - 1;
+    if (grid_y < 0) grid_y = 0;
+    if (grid_y >= GRID_HEIGHT) grid_y = GRID_HEIGHT - 1;
+    
+    int cell = grid_y * GRID_WIDTH + grid_x;
+    
+    // Final sanity check
+    if (cell < 0 || cell >= GRID_CELL_COUNT) {
+        // If we somehow got here with an invalid cell, return a safe default
+        return 0;
+    }
+    
+    return cell;
+}
+
+static Category entity_category(int id) {
+    return fish_is_big(id) ? CATEGORY_BIG_FISH : CATEGORY_SMALL_FISH;
+}
+
+// Bin every live entity that has a category; a counting sort, so there's no
+// per-cell capacity to overflow
+static void broadphase_build(void) {
+    uint8_t bucket_of[BROADPHASE_END - BROADPHASE_FIRST];
+    uint8_t counts[BROADPHASE_BUCKETS] = {0};
+    
+    for (int id = BROADPHASE_FIRST; id < BROADPHASE_END; id++) {
+        if (!entity_active(id)) continue;
+        int bucket = get_grid_cell(entity_pos(id)) * CATEGORY_COUNT + entity_category(id);
+        bucket_of[id - BROADPHASE_FIRST] = bucket;
+        counts[bucket]++;
+    }
+    
+    s_broadphase_start[0] = 0;
+    for (int b = 0; b < BROADPHASE_BUCKETS; b++) {
+        s_broadphase_start[b + 1] = s_broadphase_start[b] + counts[b];
+        counts[b] = s_broadphase_start[b];  // Now the next free index
+    }
+    
+    for (int id = BROADPHASE_FIRST; id < BROADPHASE_END; id++) {
+        if (!entity_active(id)) continue;
+        s_broadphase_ids[counts[bucket_of[id - BROADPHASE_FIRST]]++] = id;
+    }
+}
+
+// The area within dx and dy of a position, for queries
+static GRect reach_around(GPoint pos, int dx, int dy) {
+    return GRect(pos.x - dx, pos.y - dy, 2 * dx + 1, 2 * dy + 1);
+}
+
+// Collect the ids of the given categories binned in cells that area overlaps,
+// cell by cell in row order and by id within a cell. They are only
+// candidates: callers still test each one, and anything deactivated since the
+// last build is included.
+static int broadphase_query(GRect area, uint8_t categories, uint8_t *ids, int max_ids) {
+    int first = get_grid_cell(area.origin);
+    int last = get_grid_cell(GPoint(area.origin.x + area.size.w - 1, area.origin.y + area.size.h - 1));
+    int count = 0;
+    
+    for (int cell_y = first / GRID_WIDTH; cell_y <= last / GRID_WIDTH; cell_y++) {
+        for (int cell_x = first % GRID_WIDTH; cell_x <= last % GRID_WIDTH; cell_x++) {
+            for (int category = 0; category < CATEGORY_COUNT; category++) {
+                if (!(categories & CATEGORY_MASK(category))) continue;
+                
+                int bucket = (cell_y * GRID_WIDTH + cell_x) * CATEGORY_COUNT + category;
+                for (int k = s_broadphase_start[bucket]; k < s_broadphase_start[bucket + 1]; k++) {
+                    if (count == max_ids) return count;
+                    ids[count++] = s_broadphase_ids[k];
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Put query results in id order; an insertion sort suits the few there are
+static void broadphase_sort(uint8_t *ids, int count) {
+    for (int k = 1; k < count; k++) {
+        uint8_t id = ids[k];
+        int j = k;
+        for (; j > 0 && ids[j - 1] > id; j--) ids[j] = ids[j - 1];
+        ids[j] = id;
+    }
+}
+
+// Direct framebuffer rendering
+// Plankton dots, small fish bodies and bubble outlines are only a few pixels
+// each, so the graphics API's per-call overhead outweighs the drawing. This
+// backend writes them straight into the framebuffer instead, one row span
+// at a time. The framebuffer is captured on the first direct draw and held
+// across the ones that follow; anything drawn through the API releases it
+// first. Set DIRECT_FRAMEBUFFER to 0 to draw everything through the API,
+// which remains the reference.
+//
+// Color firmware anti-aliases circles and these spans don't, so there the
+// shapes would come out with hard edges; the backend is only on by default
+// for black and white, where the API draws the same pixels.
+#if defined(PBL_PLATFORM_APLITE) || defined(PBL_PLATFORM_DIORITE) || \
+    defined(PBL_PLATFORM_BASALT) || defined(PBL_PLATFORM_CHALK)
+#define FRAMEBUFFER_ACCESS 1
+#else
+#define FRAMEBUFFER_ACCESS 0    // Framebuffer layout not verified
+#endif
+
+#ifndef DIRECT_FRAMEBUFFER
+#if FRAMEBUFFER_ACCESS && defined(PBL_BW)
+#define DIRECT_FRAMEBUFFER 1
+#else
+#define DIRECT_FRAMEBUFFER 0
+#endif
+#endif
+
+static GBitmap *s_framebuffer;  // Captured framebuffer, NULL while the API owns it
+static int s_framebuffer_height;
+
+static bool framebuffer_acquire(GContext *ctx) {
+#if FRAMEBUFFER_ACCESS
+    if (!s_framebuffer) {
+        s_framebuffer = graphics_capture_frame_buffer(ctx);
+        if (s_framebuffer) {
+            s_framebuffer_height = gbitmap_get_bounds(s_framebuffer).size.h;
+        }
+    }
+#endif
+    return s_framebuffer != NULL;
+}
+
+static void framebuffer_release(GContext *ctx) {
+    if (s_framebuffer) {
+        graphics_release_frame_buffer(ctx, s_framebuffer);
+        s_framebuffer = NULL;
+    }
+}
+
+// Fill x0..x1 of row y, clipped to the part of the row that exists
+static void framebuffer_hspan(int y, int x0, int x1, GColor color) {
+    if (y < 0 || y >= s_framebuffer_height) return;
+    
+    GBitmapDataRowInfo row = gbitmap_get_data_row_info(s_framebuffer, y);
+    if (x0 < row.min_x) x0 = row.min_x;
+    if (x1 > row.max_x) x1 = row.max_x;
+    if (x0 > x1) return;
+    
+#if defined(PBL_BW)
+    // 1bpp, least significant bit first: masked bytes at the ends, whole ones between
+    uint8_t head = (uint8_t)(0xFF << (x0 % 8));
+    uint8_t tail = (uint8_t)(0xFF >> (7 - x1 % 8));
+    uint8_t *first = row.data + x0 / 8;
+    uint8_t *last = row.data + x1 / 8;
+    bool white = gcolor_equal(color, GColorWhite);
+    if (first == last) {
+        head &= tail;
+    }
+    *first = white ? (*first | head) : (*first & ~head);
+    if (first == last) return;
+    if (last - first > 1) {
+        memset(first + 1, white ? 0xFF : 0x00, last - first - 1);
+    }
+    *last = white ? (*last | tail) : (*last & ~tail);
+#else
+    // 8bpp: one byte per pixel
+    memset(row.data + x0, color.argb, x1 - x0 + 1);
+#endif
+}
+
+static void framebuffer_fill_circle(GPoint center, int radius, GColor color) {
+    for (int dy = -radius; dy <= radius; dy++) {
+        // Widest half-span that stays inside the circle
+        int half = radius;
+        while (half * half + dy * dy > radius * radius) half--;
+        framebuffer_hspan(center.y + dy, center.x - half, center.x + half, color);
+    }
+}
+
+// The pixels at left and right of row y
+static void framebuffer_plot_pair(int y, int left, int right, GColor color) {
+    if (y < 0 || y >= s_framebuffer_height) return;
+    
+    GBitmapDataRowInfo row = gbitmap_get_data_row_info(s_framebuffer, y);
+    int xs[2] = {left, right};
+    for (int i = 0; i < 2; i++) {
+        int x = xs[i];
+        if (x < row.min_x || x > row.max_x) continue;
+#if defined(PBL_BW)
+        uint8_t bit = (uint8_t)(1 << (x % 8));
+        row.data[x / 8] = gcolor_equal(color, GColorWhite) ? (row.data[x / 8] | bit) : (row.data[x / 8] & ~bit);
+#else
+        row.data[x] = color.argb;
+#endif
+    }
+}
+
+// Midpoint circle, one octant mirrored eight ways
+static void framebuffer_draw_circle(GPoint center, int radius, GColor color) {
+    int x = radius, y = 0, err = 1 - x;
+    while (x >= y) {
+        framebuffer_plot_pair(center.y + y, center.x - x, center.x + x, color);
+        framebuffer_plot_pair(center.y - y, center.x - x, center.x + x, color);
+        framebuffer_plot_pair(center.y + x, center.x - y, center.x + y, color);
+        framebuffer_plot_pair(center.y - x, center.x - y, center.x + y, color);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+// Direct versions of the draw routines; each returns false if the API
+// version has to draw instead
+static bool draw_plankton_direct(GContext *ctx, int id) {
+    if (!DIRECT_FRAMEBUFFER) return false;
+    if (entity_active(id)) {
+        batch_framebuffer_fill_circle(ctx, entity_pos(id), 1, GColorWhite);
+    }
+    return true;
+}
+
+static bool draw_bubble_direct(GContext *ctx, int id) {
+    if (!DIRECT_FRAMEBUFFER) return false;
+    if (entity_active(id)) {
+        batch_framebuffer_draw_circle(ctx, entity_pos(id), entity_size(id), GColorWhite);
+    }
+    return true;
+}
+
+// Small fish are all white, so the tail can go first and the body after it
+static bool draw_fish_direct(GContext *ctx, int id) {
+    if (!DIRECT_FRAMEBUFFER || fish_is_big(id)) return false;
+    if (!entity_active(id)) return true;
+    
+    batch_set_fill_color(ctx, GColorWhite);
+    draw_fish_tail(ctx, id);
+    batch_framebuffer_fill_circle(ctx, entity_pos(id), fish_radius(id), GColorWhite);
+    return true;
+}
+
+// Dirty-rectangle rendering
+// The window background is clear, so whatever was drawn last frame is still
+// in the framebuffer. Each frame only the areas where something changed are
+// cleared, and only the entities overlapping them are drawn again.
+
+// Every entity has a draw slot, indexed by entity id
+
+#define MAX_DAMAGE_RECTS 8
+#define DAMAGE_PAD 2              // Slack around each entity for stroke width and anti-aliasing
+#define FULL_REDRAW_PERCENT 60    // Past this much damage a single full clear is cheaper
+
+typedef struct {
+    GRect bounds;   // Screen area it covers once the damage is repainted (empty if nothing)
+    uint32_t key;   // Hash of everything else that affects how it's drawn
+} DrawSlot;
+
+static DrawSlot s_draw_slots[ENTITY_COUNT];
+static GRect s_damage[MAX_DAMAGE_RECTS];
+static int s_damage_count;
+static bool s_full_redraw = true;  // Set whenever the framebuffer can't be trusted
+static uint32_t s_culled_draws;    // Live entities skipped for being out of view, for instrumentation
+
+// Part of the canvas not covered by system UI such as a Timeline Quick View.
+// While some of it is covered, creatures entirely underneath are neither
+// drawn nor animated.
+static GRect s_visible_bounds;
+static bool s_obstructed;
+
+// Force the next frame to clear and redraw the whole canvas
+static void request_full_redraw(void) {
+    s_full_redraw = true;
+    if (s_canvas_layer) {
+        layer_mark_dirty(s_canvas_layer);
+    }
+}
+
+static bool rect_is_empty(GRect rect) {
+    return rect.size.w <= 0 || rect.size.h <= 0;
+}
+
+static bool rect_intersects(GRect a, GRect b) {
+    if (rect_is_empty(a) || rect_is_empty(b)) return false;
+    return a.origin.x < b.origin.x + b.size.w && b.origin.x < a.origin.x + a.size.w &&
+           a.origin.y < b.origin.y + b.size.h && b.origin.y < a.origin.y + a.size.h;
+}
+
+static GRect rect_union(GRect a, GRect b) {
+    int x0 = a.origin.x < b.origin.x ? a.origin.x : b.origin.x;
+    int y0 = a.origin.y < b.origin.y ? a.origin.y : b.origin.y;
+    int x1 = a.origin.x + a.size.w > b.origin.x + b.size.w ? a.origin.x + a.size.w : b.origin.x + b.size.w;
+    int y1 = a.origin.y + a.size.h > b.origin.y + b.size.h ? a.origin.y + a.size.h : b.origin.y + b.size.h;
+    return (GRect){ .origin = {x0, y0}, .size = {x1 - x0, y1 - y0} };
+}
+
+// Bounding box from how far a shape reaches on each side of its position
+static GRect rect_around(GPoint pos, int left, int top, int right, int bottom) {
+    return (GRect){
+        .origin = {pos.x - left - DAMAGE_PAD, pos.y - top - DAMAGE_PAD},
+        .size = {left + right + 1 + 2 * DAMAGE_PAD, top + bottom + 1 + 2 * DAMAGE_PAD}
+    };
+}
+
+// Same, for shapes that face along their swimming direction
+static GRect rect_facing(GPoint pos, int direction, int back, int front, int top, int bottom) {
+    return direction == 1 ? rect_around(pos, back, top, front, bottom)
+                          : rect_around(pos, front, top, back, bottom);
+}
+
+// Farthest any pose of a species reaches from its position, facing either
+// way. Coarser than the bounds in slot_state but needs no pose, so it's a
+// cheap first test of whether an entity can be seen at all.
+typedef struct {
+    int8_t left;
+    int8_t top;
+    int8_t right;
+    int8_t bottom;
+} SpeciesExtent;
+
+static const SpeciesExtent s_species_extents[SPECIES_COUNT] = {
+    [SPECIES_SEAWEED] = { 12, SEAWEED_SEGMENTS * SEAWEED_SEGMENT_LENGTH, 12, 0 },  // Sway of up to 2 per segment
+    [SPECIES_CLAM] = { 5, 8, 5, 2 },
+    [SPECIES_CRAB] = { 6, 4, 6, 3 },
+    [SPECIES_PLANKTON] = { 1, 1, 1, 1 },
+    [SPECIES_TURTLE] = { 13, 5, 13, 6 },
+    [SPECIES_JELLYFISH] = { 21, 24, 21, 15 },   // Bell at its largest
+    [SPECIES_SEAHORSE] = { 12, 8, 7, 39 },
+    [SPECIES_FISH] = { 14, 7, 14, 7 },          // Big fish
+    [SPECIES_BUBBLE] = { 3, 3, 3, 3 },
+    [SPECIES_OCTOPUS] = { 20, 20, 20, 20 },
+    [SPECIES_SHARK] = { 25, 16, 25, 8 },
+};
+
+// Whether an entity might show on the visible part of the canvas
+static bool entity_in_view(int id) {
+    const SpeciesExtent *extent = &s_species_extents[entity_species(id)];
+    GRect bounds = rect_around(entity_pos(id), extent->left, extent->top, extent->right, extent->bottom);
+    return rect_intersects(bounds, s_visible_bounds) && scene_rect_visible(bounds);
+}
+
+// Areas covered by the creatures that have cached sprites
+static GRect turtle_bounds(GPoint pos, int direction) {
+    return rect_facing(pos, direction, 12, 13, 5, 6);
+}
+
+static GRect crab_bounds(GPoint pos) {
+    return rect_around(pos, 6, 4, 6, 3);
+}
+
+static GRect clam_bounds(GPoint pos, int open_amount) {
+    return rect_around(pos, 5, 4 + open_amount, 5, 2);
+}
+
+static GRect seahorse_bounds(GPoint pos) {
+    return rect_around(pos, 12, 8, 7, 39);
+}
+
+static uint32_t hash_add(uint32_t hash, int32_t value) {
+    return (hash ^ (uint32_t)value) * 16777619u;  // FNV-1a step
+}
+
+// Sprite cache
+// The turtle, crab, clam and seahorse only ever take a handful of poses, so
+// each pose is drawn once into a bitmap and blitted from then on. Black and
+// white bitmaps have no transparency, so there each pose also keeps a mask
+// of the pixels it covers; color ones use the alpha channel instead, which
+// also keeps anti-aliased edges partly transparent.
+
+// Heap budget for sprite pixels, overridable from the build. Poses that
+// don't fit are drawn as vectors.
+#ifndef SPRITE_CACHE_BYTES
+#if defined(PBL_PLATFORM_APLITE)
+#define SPRITE_CACHE_BYTES 2560     // Everything but the seahorse
+#else
+#define SPRITE_CACHE_BYTES 16384
+#endif
+#endif
+
+#define CRAB_CLAW_POSES 2           // crab_claw_offset() is 0 or 1
+#define CLAM_OPEN_POSES 5           // clam_open_amount() is 0..4
+#define TURTLE_FLIPPER_POSES 5      // turtle_flipper_offset() is -2..2
+#define SEAHORSE_CURVE_POSES 5      // seahorse_curve_offset() is -2..2
+
+// Ordered smallest first, which is also the order the budget is spent in
+enum {
+    SPRITE_CRAB = 0,
+    SPRITE_CLAM = SPRITE_CRAB + CRAB_CLAW_POSES,
+    SPRITE_TURTLE = SPRITE_CLAM + CLAM_OPEN_POSES,  // Facing right, then left
+    SPRITE_SEAHORSE = SPRITE_TURTLE + 2 * TURTLE_FLIPPER_POSES,
+    SPRITE_COUNT = SPRITE_SEAHORSE + SEAHORSE_CURVE_POSES
+};
+
+typedef struct {
+    GBitmap *image;   // The pose drawn over black
+#if defined(PBL_BW)
+    GBitmap *mask;    // White wherever the pose covers what's behind it
+#endif
+    GRect box;        // Where the bitmap goes relative to the creature's position
+} Sprite;
+
+static Sprite s_sprites[SPRITE_COUNT];
+static size_t s_sprite_bytes;
+static bool s_sprites_built;
+
+static int crab_sprite(void) {
+    return SPRITE_CRAB + crab_claw_offset();
+}
+
+static int clam_sprite(void) {
+    return SPRITE_CLAM + clam_open_amount();
+}
+
+static int turtle_sprite(int id) {
+    int facing = entity_direction(id) == 1 ? 0 : TURTLE_FLIPPER_POSES;
+    return SPRITE_TURTLE + facing + turtle_flipper_offset(id) + 2;
+}
+
+static int seahorse_sprite(void) {
+    return SPRITE_SEAHORSE + seahorse_curve_offset() + 2;
+}
+
+// Draw a sprite's pose as vectors, with the creature at pos
+static void draw_sprite_pose(GContext *ctx, int sprite, GPoint pos) {
+    if (sprite < SPRITE_CLAM) {
+        draw_crab_pose(ctx, pos, sprite - SPRITE_CRAB);
+    } else if (sprite < SPRITE_TURTLE) {
+        draw_clam_pose(ctx, pos, sprite - SPRITE_CLAM);
+    } else if (sprite < SPRITE_SEAHORSE) {
+        int pose = sprite - SPRITE_TURTLE;
+        int direction = pose < TURTLE_FLIPPER_POSES ? 1 : -1;
+        draw_turtle_pose(ctx, pos, direction, pose % TURTLE_FLIPPER_POSES - 2);
+    } else {
+        draw_seahorse_pose(ctx, pos, sprite - SPRITE_SEAHORSE - 2);
+    }
+}
+
+// Area a sprite's pose covers, relative to the creature's position
+static GRect sprite_box(int sprite) {
+    if (sprite < SPRITE_CLAM) return crab_bounds(GPointZero);
+    if (sprite < SPRITE_TURTLE) return clam_bounds(GPointZero, sprite - SPRITE_CLAM);
+    if (sprite < SPRITE_SEAHORSE) {
+        return turtle_bounds(GPointZero, sprite - SPRITE_TURTLE < TURTLE_FLIPPER_POSES ? 1 : -1);
+    }
+    return seahorse_bounds(GPointZero);
+}
+
+static size_t sprite_bytes(GSize size) {
+#if defined(PBL_BW)
+    return 2 * ((size.w + 31) / 32) * 4 * size.h;  // Image and mask, rows padded to 32 bits
+#else
+    return size.w * size.h;
+#endif
+}
+
+#if defined(PBL_BW)
+static bool bitmap_row_is_white(const uint8_t *row, int x) {
+    return row[x / 8] & (1 << (x % 8));
+}
+
+static void bitmap_row_set_white(uint8_t *row, int x) {
+    row[x / 8] |= 1 << (x % 8);
+}
+#else
+// One pixel of a pose from its renders over black and over white.
+// Anti-aliased edges are blended with the background, so each channel over
+// white is the one over black plus the background's share of 3, and 3 less
+// that share is how much of the pixel the pose covers. That goes in the
+// alpha channel, so the edge blends with whatever the sprite is drawn over.
+static uint8_t sprite_pixel(uint8_t over_black, uint8_t over_white) {
+    GColor black = (GColor8){ .argb = over_black };
+    GColor white = (GColor8){ .argb = over_white };
+    int share = ((white.r - black.r) + (white.g - black.g) + (white.b - black.b) + 1) / 3;
+    int alpha = 3 - (share < 0 ? 0 : share > 3 ? 3 : share);
+    if (alpha == 0) return GColorClearARGB8;
+    
+    // Undo the blend with black
+    int r = (black.r * 3 + alpha / 2) / alpha;
+    int g = (black.g * 3 + alpha / 2) / alpha;
+    int b = (black.b * 3 + alpha / 2) / alpha;
+    return (GColor8){
+        .a = alpha,
+        .r = r > 3 ? 3 : r,
+        .g = g > 3 ? 3 : g,
+        .b = b > 3 ? 3 : b,
+    }.argb;
+}
+#endif
+
+// Draw a pose over a patch of background and hand back the framebuffer
+static GBitmap *sprite_render(GContext *ctx, int sprite, GPoint pos, GRect area, GColor background) {
+    graphics_context_set_fill_color(ctx, background);
+    graphics_fill_rect(ctx, area, 0, GCornerNone);
+    draw_sprite_pose(ctx, sprite, pos);
+    return graphics_capture_frame_buffer(ctx);
+}
+
+// Render every pose that fits in the budget. There's no offscreen drawing,
+// so each pose is drawn on screen, read back from the framebuffer and then
+// drawn over by the full redraw this forces.
+static void sprite_cache_build(GContext *ctx, GRect bounds) {
+    s_sprites_built = true;
+    s_full_redraw = true;
+    
+    // Work around the middle of the screen, which is visible on round displays too
+    GPoint center = grect_center_point(&bounds);
+    
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        Sprite *sprite = &s_sprites[i];
+        GRect box = sprite_box(i);
+        size_t bytes = sprite_bytes(box.size);
+        if (s_sprite_bytes + bytes > SPRITE_CACHE_BYTES) continue;
+        
+        sprite->image = gbitmap_create_blank(box.size, PBL_IF_BW_ELSE(GBitmapFormat1Bit, GBitmapFormat8Bit));
+#if defined(PBL_BW)
+        sprite->mask = gbitmap_create_blank(box.size, GBitmapFormat1Bit);
+        if (!sprite->mask) {
+            gbitmap_destroy(sprite->image);
+            sprite->image = NULL;
+        }
+#endif
+        if (!sprite->image) {
+            APP_LOG(APP_LOG_LEVEL_WARNING, "Out of memory for sprite %d", i);
+            continue;
+        }
+        
+        GRect area = (GRect){
+            .origin = {center.x - box.size.w / 2, center.y - box.size.h / 2},
+            .size = box.size
+        };
+        GPoint pos = (GPoint){area.origin.x - box.origin.x, area.origin.y - box.origin.y};
+        uint8_t *image = gbitmap_get_data(sprite->image);
+        uint16_t image_stride = gbitmap_get_bytes_per_row(sprite->image);
+        
+        // Over black: the pose's own pixels
+        GBitmap *framebuffer = sprite_render(ctx, i, pos, area, GColorBlack);
+        if (!framebuffer) break;
+        for (int y = 0; y < area.size.h; y++) {
+            GBitmapDataRowInfo row = gbitmap_get_data_row_info(framebuffer, area.origin.y + y);
+            uint8_t *image_row = image + y * image_stride;
+            for (int x = 0; x < area.size.w; x++) {
+                int screen_x = area.origin.x + x;
+                if (screen_x < row.min_x || screen_x > row.max_x) continue;
+#if defined(PBL_BW)
+                if (bitmap_row_is_white(row.data, screen_x)) bitmap_row_set_white(image_row, x);
+#else
+                image_row[x] = row.data[screen_x];
+#endif
+            }
+        }
+        graphics_release_frame_buffer(ctx, framebuffer);
+        
+        // Over white: on black and white, whatever is now not white, or was
+        // not black, is covered; on color, how much changed says how much
+        framebuffer = sprite_render(ctx, i, pos, area, GColorWhite);
+        if (!framebuffer) break;
+#if defined(PBL_BW)
+        uint8_t *mask = gbitmap_get_data(sprite->mask);
+        uint16_t mask_stride = gbitmap_get_bytes_per_row(sprite->mask);
+#endif
+        for (int y = 0; y < area.size.h; y++) {
+            GBitmapDataRowInfo row = gbitmap_get_data_row_info(framebuffer, area.origin.y + y);
+            uint8_t *image_row = image + y * image_stride;
+            for (int x = 0; x < area.size.w; x++) {
+                int screen_x = area.origin.x + x;
+                if (screen_x < row.min_x || screen_x > row.max_x) continue;
+#if defined(PBL_BW)
+                if (bitmap_row_is_white(image_row, x) || !bitmap_row_is_white(row.data, screen_x)) {
+                    bitmap_row_set_white(mask + y * mask_stride, x);
+                }
+#else
+                image_row[x] = sprite_pixel(image_row[x], row.data[screen_x]);
+#endif
+            }
+        }
+        graphics_release_frame_buffer(ctx, framebuffer);
+        
+        sprite->box = box;
+        s_sprite_bytes += bytes;
+    }
+}
+
+static void sprite_cache_destroy(void) {
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        if (s_sprites[i].image) gbitmap_destroy(s_sprites[i].image);
+#if defined(PBL_BW)
+        if (s_sprites[i].mask) gbitmap_destroy(s_sprites[i].mask);
+#endif
+        s_sprites[i] = (Sprite){0};
+    }
+    s_sprite_bytes = 0;
+    s_sprites_built = false;
+}
+
+// Blit a cached pose; false if it isn't cached and has to be drawn as vectors
+static bool draw_sprite(GContext *ctx, int sprite, GPoint pos) {
+    const Sprite *cached = &s_sprites[sprite];
+    if (!cached->image) return false;
+    
+    GRect rect = cached->box;
+    rect.origin.x += pos.x;
+    rect.origin.y += pos.y;
+#if defined(PBL_BW)
+    batch_set_compositing_mode(ctx, GCompOpClear);
+    batch_draw_sprite(ctx, sprite, true, rect);
+    batch_set_compositing_mode(ctx, GCompOpOr);
+    batch_draw_sprite(ctx, sprite, false, rect);
+#else
+    batch_set_compositing_mode(ctx, GCompOpSet);
+    batch_draw_sprite(ctx, sprite, false, rect);
+#endif
+    return true;
+}
+
+// Batch replay
+// A batch is a run of recorded commands that share their state, linked in
+// draw order through s_batch_next.
+typedef struct {
+    uint8_t first;
+    uint8_t last;
+    GRect bounds;                   // Union of its commands' bounds
+} Batch;
+
+static Batch s_batches[BATCH_COMMANDS];
+static uint8_t s_batch_next[BATCH_COMMANDS];
+
+static BatchState batch_state(uint8_t op) {
+    switch (op) {
+        case BATCH_FILL_CIRCLE:
+        case BATCH_FILL_RECT:
+        case BATCH_FILL_PATH:
+            return BATCH_STATE_FILL;
+        case BATCH_DRAW_LINE:
+        case BATCH_DRAW_CIRCLE:
+            return BATCH_STATE_STROKE;
+        case BATCH_DRAW_SPRITE:
+            return BATCH_STATE_BITMAP;
+        default:
+            return BATCH_STATE_FRAMEBUFFER;
+    }
+}
+
+static bool batch_same_state(const BatchCommand *a, const BatchCommand *b) {
+    BatchState state = batch_state(a->op);
+    if (state != batch_state(b->op)) return false;
+    switch (state) {
+        case BATCH_STATE_FILL:
+            return gcolor_equal(a->color, b->color);
+        case BATCH_STATE_STROKE:
+            return gcolor_equal(a->color, b->color) && a->mode == b->mode;
+        case BATCH_STATE_BITMAP:
+            return a->mode == b->mode;
+        default:
+            return true;
+    }
+}
+
+static bool batch_overlaps(const Batch *batch, GRect bounds) {
+    if (!rect_intersects(batch->bounds, bounds)) return false;
+    for (int i = batch->first; ; i = s_batch_next[i]) {
+        if (rect_intersects(s_batch_commands[i].bounds, bounds)) return true;
+        if (i == batch->last) return false;
+    }
+}
+
+// Context state setters that skip what the context already holds
+static void batch_apply_fill_color(GContext *ctx, GColor color) {
+    if ((s_batch_known & BATCH_KNOWN_FILL) && gcolor_equal(s_batch_applied.fill_color, color)) return;
+    graphics_context_set_fill_color(ctx, color);
+    s_batch_applied.fill_color = color;
+    if (s_batch_recording) s_batch_known |= BATCH_KNOWN_FILL;
+}
+
+static void batch_apply_stroke(GContext *ctx, GColor color, uint8_t width) {
+    if (!(s_batch_known & BATCH_KNOWN_STROKE) || !gcolor_equal(s_batch_applied.stroke_color, color)) {
+        graphics_context_set_stroke_color(ctx, color);
+        s_batch_applied.stroke_color = color;
+        if (s_batch_recording) s_batch_known |= BATCH_KNOWN_STROKE;
+    }
+    if (!(s_batch_known & BATCH_KNOWN_WIDTH) || s_batch_applied.stroke_width != width) {
+        graphics_context_set_stroke_width(ctx, width);
+        s_batch_applied.stroke_width = width;
+        if (s_batch_recording) s_batch_known |= BATCH_KNOWN_WIDTH;
+    }
+}
+
+static void batch_apply_compositing_mode(GContext *ctx, GCompOp mode) {
+    if ((s_batch_known & BATCH_KNOWN_COMPOSITING) && s_batch_applied.compositing_mode == mode) return;
+    graphics_context_set_compositing_mode(ctx, mode);
+    s_batch_applied.compositing_mode = mode;
+    if (s_batch_recording) s_batch_known |= BATCH_KNOWN_COMPOSITING;
+}
+
+// Set the context up for a command's batch
+static void batch_apply(GContext *ctx, const BatchCommand *command) {
+    switch (batch_state(command->op)) {
+        case BATCH_STATE_FILL:
+            batch_apply_fill_color(ctx, command->color);
+            break;
+        case BATCH_STATE_STROKE:
+            batch_apply_stroke(ctx, command->color, command->mode);
+            break;
+        case BATCH_STATE_BITMAP:
+            batch_apply_compositing_mode(ctx, (GCompOp)command->mode);
+            break;
+        default:
+            break;
+    }
+}
+
+// Draw one command in the state the context is already in
+static void batch_run(GContext *ctx, const BatchCommand *command) {
+    if (batch_state(command->op) != BATCH_STATE_FRAMEBUFFER) {
+        framebuffer_release(ctx);
+    }
+    
+    switch (command->op) {
+        case BATCH_FILL_CIRCLE:
+            graphics_fill_circle(ctx, command->shape.circle.center, command->shape.circle.radius);
+            break;
+        case BATCH_FILL_RECT:
+            graphics_fill_rect(ctx, command->shape.rect.rect, command->shape.rect.corner_radius,
+                               command->shape.rect.corners);
+            break;
+        case BATCH_FILL_PATH:
+            if (!s_batch_path) break;
+            for (int i = 0; i < command->count; i++) {
+                s_batch_path_points[i] = GPoint(command->bounds.origin.x + command->shape.points[i][0],
+                                                command->bounds.origin.y + command->shape.points[i][1]);
+            }
+            s_batch_path->num_points = command->count;
+            gpath_draw_filled(ctx, s_batch_path);
+            break;
+        case BATCH_DRAW_LINE:
+            graphics_draw_line(ctx, command->shape.line.from, command->shape.line.to);
+            break;
+        case BATCH_DRAW_CIRCLE:
+            graphics_draw_circle(ctx, command->shape.circle.center, command->shape.circle.radius);
+            break;
+        case BATCH_DRAW_SPRITE: {
+            const Sprite *sprite = &s_sprites[command->shape.sprite.index];
+#if defined(PBL_BW)
+            GBitmap *bitmap = command->shape.sprite.mask ? sprite->mask : sprite->image;
+#else
+            GBitmap *bitmap = sprite->image;
+#endif
+            if (!bitmap) break;
+            graphics_draw_bitmap_in_rect(ctx, bitmap, (GRect){ command->shape.sprite.origin, sprite->box.size });
+            break;
+        }
+        case BATCH_FRAMEBUFFER_FILL_CIRCLE:
+            if (framebuffer_acquire(ctx)) {
+                framebuffer_fill_circle(command->shape.circle.center, command->shape.circle.radius,
+                                        command->color);
+            } else {
+                batch_apply_fill_color(ctx, command->color);
+                graphics_fill_circle(ctx, command->shape.circle.center, command->shape.circle.radius);
+            }
+            break;
+        case BATCH_FRAMEBUFFER_DRAW_CIRCLE:
+            if (framebuffer_acquire(ctx)) {
+                framebuffer_draw_circle(command->shape.circle.center, command->shape.circle.radius,
+                                        command->color);
+            } else {
+                batch_apply_stroke(ctx, command->color, 1);
+                graphics_draw_circle(ctx, command->shape.circle.center, command->shape.circle.radius);
+            }
+            break;
     }
-    
-    // Draw the curled tail - tightly curled at the end
-    GPoint tail_points[4];
-    tail_points[0] = body_segments[6];
-    tail_points[1].x = body_segments[6].x - 2;
-    tail_points[1].y = body_segments[6].y + 3;
-    tail_points[2].x = body_segments[6].x - 4;
-    tail_points[2].y = body_segments[6].y + 2;
-    tail_points[3].x = body_segments[6].x - 5;
-    tail_points[3].y = body_segments[6].y - 1;
-    
-    graphics_context_set_stroke_width(ctx, 2);
-    for (int i = 1; i < 4; i++) {
-        graphics_draw_line(ctx, tail_points[i-1], tail_points[i]);
+}
+
+// Draw everything recorded so far, batch by batch
+static void batch_flush(GContext *ctx) {
+    int batch_count = 0;
+    for (int i = 0; i < s_batch_count; i++) {
+        const BatchCommand *command = &s_batch_commands[i];
+        
+        // Join the latest batch in the same state, unless a batch after it
+        // draws under this command and would end up on top of it. A frame
+        // has only a few states, so looking further back than
+        // BATCH_GROUP_SCAN batches finds nothing more; the limit keeps a
+        // list of many states from costing a scan per pair.
+        int join = -1;
+        int oldest = batch_count > BATCH_GROUP_SCAN ? batch_count - BATCH_GROUP_SCAN : 0;
+        for (int b = batch_count - 1; b >= oldest; b--) {
+            if (batch_same_state(&s_batch_commands[s_batches[b].first], command)) {
+                join = b;
+                break;
+            }
+            if (batch_overlaps(&s_batches[b], command->bounds)) break;
+        }
+        
+        if (join < 0) {
+            s_batches[batch_count++] = (Batch){ .first = i, .last = i, .bounds = command->bounds };
+        } else {
+            Batch *batch = &s_batches[join];
+            s_batch_next[batch->last] = i;
+            batch->last = i;
+            batch->bounds = rect_union(batch->bounds, command->bounds);
+        }
     }
     
-    // Draw the characteristic bulging belly - seahorses have a distinct pouch
-    graphics_context_set_fill_color(ctx, GColorWhite);
-    GPoint belly_center = (GPoint){
-        body_segments[3].x - 4,
-        body_segments[3].y
-    };
-    graphics_fill_circle(ctx, belly_center, 3);
-    
-    // Draw dorsal fin - on the back
-    graphics_context_set_stroke_width(ctx, 1);
-    GPoint dorsal_fin[3] = {
-        {body_segments[2].x, body_segments[2].y},
-        {body_segments[2].x - 4, body_segments[2].y - 5},
-        {body_segments[2].x + 2, body_segments[2].y - 2}
-    };
-    
-    for (int i = 0; i < 2; i++) {
-        graphics_draw_line(ctx, dorsal_fin[i], dorsal_fin[i+1]);
+    for (int b = 0; b < batch_count; b++) {
+        const Batch *batch = &s_batches[b];
+        batch_apply(ctx, &s_batch_commands[batch->first]);
+        for (int i = batch->first; ; i = s_batch_next[i]) {
+            batch_run(ctx, &s_batch_commands[i]);
+            if (i == batch->last) break;
+        }
+    }
+    s_batch_count = 0;
+}
+
+// Record everything drawn until batch_end; nothing about the context's
+// state is assumed until a batch sets it
+static void batch_begin(void) {
+    s_batch_recording = true;
+    s_batch_count = 0;
+    s_batch_known = 0;
+}
+
+static void batch_end(GContext *ctx) {
+    batch_flush(ctx);
+    s_batch_recording = false;
+    s_batch_known = 0;
+}
+
+// Current bounds and appearance key of one slot
+static DrawSlot slot_state(int slot) {
+    DrawSlot state = { .bounds = GRectZero, .key = 2166136261u };
+    GPoint pos = entity_pos(slot);
+    
+    if (slot < ENTITY_CLAM) {
+        int8_t sway[SEAWEED_SEGMENTS];
+        seaweed_sway(slot, sway);
+        int x = 0, min_x = 0, max_x = 0;
+        for (int i = 0; i < SEAWEED_SEGMENTS; i++) {
+            x += sway[i];
+            if (x < min_x) min_x = x;
+            if (x > max_x) max_x = x;
+            state.key = hash_add(state.key, sway[i]);
+        }
+        state.bounds = rect_around(GPoint(pos.x + min_x, pos.y),
+                                   0, SEAWEED_SEGMENTS * SEAWEED_SEGMENT_LENGTH, max_x - min_x, 0);
+    } else if (slot == ENTITY_CLAM) {
+        int open_amount = clam_open_amount();
+        state.bounds = clam_bounds(pos, open_amount);
+        state.key = hash_add(state.key, open_amount);
+    } else if (slot == ENTITY_CRAB) {
+        state.bounds = crab_bounds(pos);
+        state.key = hash_add(state.key, crab_claw_offset());
+    } else if (slot < ENTITY_TURTLE) {
+        if (entity_active(slot)) {
+            state.bounds = rect_around(pos, 1, 1, 1, 1);
+        }
+    } else if (slot < ENTITY_JELLYFISH) {
+        state.bounds = turtle_bounds(pos, entity_direction(slot));
+        state.key = hash_add(state.key, turtle_flipper_offset(slot));
+    } else if (slot < ENTITY_SEAHORSE) {
+        int bell_size = jellyfish_bell_size(slot);
+        state.bounds = rect_around(pos, bell_size + 9, 2 * bell_size, bell_size + 9, 15);
+        state.key = hash_add(state.key, bell_size);
+        state.key = hash_add(state.key, s_entities.phase[slot]);
+    } else if (slot == ENTITY_SEAHORSE) {
+        if (entity_active(slot)) {
+            state.bounds = seahorse_bounds(pos);
+            state.key = hash_add(state.key, seahorse_curve_offset());
+        }
+    } else if (slot < ENTITY_BUBBLE) {
+        if (entity_active(slot)) {
+            int size = fish_radius(slot);
+            state.bounds = rect_facing(pos, entity_direction(slot), 2 * size, size, size, size);
+        }
+    } else if (slot < ENTITY_OCTOPUS) {
+        if (entity_active(slot)) {
+            int size = entity_size(slot);
+            state.bounds = rect_around(pos, size, size, size, size);
+        }
+    } else if (slot == ENTITY_OCTOPUS) {
+        // Head plus three tentacle segments of 8, 6 and 6 pixels
+        state.bounds = rect_around(pos, 20, 20, 20, 20);
+        state.key = hash_add(state.key, s_entities.phase[slot]);
+    } else if (entity_active(slot)) {
+        state.bounds = rect_facing(pos, entity_direction(slot), 25, 15, 16, 8);
     }
     
-    // Draw pectoral fin - small fin behind head
-    GPoint pectoral_fin[3] = {
-        {body_segments[1].x, body_segments[1].y},
-        {body_segments[1].x - 3, body_segments[1].y - 2},
-        {body_segments[1].x - 1, body_segments[1].y + 2}
-    };
+    return state;
+}
+
+// Whether a slot shows on the unobstructed part of the canvas
+static bool slot_visible(int slot) {
+    return !s_obstructed || rect_intersects(slot_state(slot).bounds, s_visible_bounds);
+}
+
+// Draw whatever occupies a slot
+static void draw_slot(GContext *ctx, int slot) {
+    if (slot >= ENTITY_PLANKTON && slot < ENTITY_TURTLE) {
+        if (!draw_plankton_direct(ctx, slot)) draw_plankton(ctx, slot);
+        return;
+    }
+    if (slot >= ENTITY_BUBBLE && slot < ENTITY_OCTOPUS) {
+        if (!draw_bubble_direct(ctx, slot)) draw_bubble(ctx, slot);
+        return;
+    }
+    if (slot >= ENTITY_FISH && slot < ENTITY_BUBBLE) {
+        if (!draw_fish_direct(ctx, slot)) draw_fish(ctx, slot);
+        return;
+    }
     
-    for (int i = 0; i < 2; i++) {
-        graphics_draw_line(ctx, pectoral_fin[i], pectoral_fin[i+1]);
+    // Everything else goes through the graphics API
+    GPoint pos = entity_pos(slot);
+    if (slot < ENTITY_CLAM) {
+        draw_seaweed(ctx, slot);
+    } else if (slot == ENTITY_CLAM) {
+        if (!draw_sprite(ctx, clam_sprite(), pos)) draw_clam(ctx);
+    } else if (slot == ENTITY_CRAB) {
+        if (!draw_sprite(ctx, crab_sprite(), pos)) draw_crab(ctx);
+    } else if (slot < ENTITY_JELLYFISH) {
+        if (!draw_sprite(ctx, turtle_sprite(slot), pos)) draw_turtle(ctx, slot);
+    } else if (slot < ENTITY_SEAHORSE) {
+        draw_jellyfish(ctx, slot);
+    } else if (slot == ENTITY_SEAHORSE) {
+        if (!entity_active(slot)) return;
+        if (!draw_sprite(ctx, seahorse_sprite(), pos)) draw_seahorse(ctx);
+    } else if (slot == ENTITY_OCTOPUS) {
+        draw_octopus(ctx);
+    } else {
+        draw_shark(ctx);
     }
 }
 
-// Check if two elements collide (basic circle collision)
-static bool check_collision(GPoint pos1, int radius1, GPoint pos2, int radius2) {
-    int dx = pos1.x - pos2.x;
-    int dy = pos1.y - pos2.y;
-    int distance_squared = (dx * dx) + (dy * dy);
-    int radius_sum = radius1 + radius2;
-    return distance_squared <= (radius_sum * radius_sum);
+// Background layer
+// The clam and the seahorse hardly ever change: the clam opens every twenty
+// seconds or so and the seahorse's sway shifts its pose a pixel at a time
+// over minutes. They're drawn over black into a bitmap of the band of screen
+// rows they stand in, and that band is what clearing restores instead of
+// black. Swimmers passing in front of them then don't force them to be
+// redrawn, nor pull in everything else they overlap. They keep their place
+// in the drawing order, though: where something that comes before them,
+// such as the crab under the seahorse, is drawn over the band, they're drawn
+// again on top of it. The bitmap is rebuilt when either of them changes how
+// it looks. Set BACKGROUND_CACHE to 0 to draw them like any other creature.
+#ifndef BACKGROUND_CACHE
+#define BACKGROUND_CACHE 1
+#endif
+
+static GBitmap *s_background;   // NULL if not cached; restoring it needs FRAMEBUFFER_ACCESS
+static GRect s_background_rect; // Screen rows the bitmap holds, full width
+static bool s_background_valid; // Whether it shows the clam and seahorse as recorded
+
+// Slots the background bitmap holds
+static bool slot_in_background(int slot) {
+    return slot == ENTITY_CLAM || slot == ENTITY_SEAHORSE;
 }
 
-// Calculate grid cell for a point
-static int get_grid_cell(GPoint point) {
-    // Ensure point is within bounds before calculating cell
-    if (point.x < 0) point.x = 0;
-    if (point.x >= 144) point.x = 143;  // Screen width - 1
-    if (point.y < 0) point.y = 0;
-    if (point.y >= 168) point.y = 167;  // Screen height - 1
-    
-    int grid_x = point.x / GRID_CELL_WIDTH;
-    int grid_y = point.y / GRID_CELL_HEIGHT;
-    
-    // Extra bounds check to guarantee valid result
-    if (grid_x < 0) grid_x = 0;
-    if (grid_x >= GRID_WIDTH) grid_x = GRID_WIDTH - 1;
-    if (grid_y < 0) grid_y = 0;
-    if (grid_y >= GRID_HEIGHT) grid_y = GRID_HEIGHT - 1;
-    
-    int cell = grid_y * GRID_WIDTH + grid_x;
-    
-    // Final sanity check
-    if (cell < 0 || cell >= GRID_CELL_COUNT) {
-        // If we somehow got here with an invalid cell, return a safe default
-        return 0;
+static bool slot_flagged(const uint8_t *flags, int slot) {
+    return flags[slot / 8] & (1 << (slot % 8));
+}
+
+static void slot_flag(uint8_t *flags, int slot) {
+    flags[slot / 8] |= 1 << (slot % 8);
+}
+
+// Whether a slot in the cached background has something flagged for drawing
+// before it, in id order, on top of it
+static bool background_buried(int slot, const uint8_t *flags) {
+    GRect bounds = s_draw_slots[slot].bounds;
+    if (rect_is_empty(bounds)) return false;
+    for (int i = 0; i < slot; i++) {
+        if (slot_flagged(flags, i) && rect_intersects(s_draw_slots[i].bounds, bounds)) return true;
     }
-    
-    return cell;
+    return false;
 }
 
-// Update fish spatial grid positions
-static void update_spatial_grid() {
-    // Reset grid
-    for (int i = 0; i < GRID_CELL_COUNT; i++) {
-        s_fish_grid_counts[i] = 0;
+// Draw the flagged slots back to front
+static void draw_slots(GContext *ctx, const uint8_t *flags) {
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        if (slot_flagged(flags, i)) draw_slot(ctx, i);
     }
-    
-    // Place fish in grid cells
-    for (int i = 0; i < MAX_FISH + MAX_BIG_FISH; i++) {
-        if (s_fish[i].active) {
-            int cell = get_grid_cell(s_fish[i].pos);
-            s_fish[i].grid_cell = cell;
-            
-            // Enhanced bounds check to prevent buffer overflow
-            if (cell >= 0 && cell < GRID_CELL_COUNT && s_fish_grid_counts[cell] < MAX_FISH + MAX_BIG_FISH) {
-                s_fish_in_grid[cell][s_fish_grid_counts[cell]] = i;
-                s_fish_grid_counts[cell]++;
-            }
-        }
+}
+
+// Flag every slot on screen, leaving out cached background slots that
+// nothing before them covers
+static void flag_all_slots(uint8_t *flags, bool background_only) {
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        if (rect_is_empty(s_draw_slots[i].bounds)) continue;
+        if (background_only && !slot_in_background(i)) continue;
+        if (!background_only && s_background && slot_in_background(i) && !background_buried(i, flags)) continue;
+        slot_flag(flags, i);
     }
 }
 
-// Update canvas layer
-static void canvas_update_proc(Layer *layer, GContext *ctx) {
-    // Clear the screen (black for B&W displays)
+// Copy part of a framebuffer row to or from the matching row of the
+// background, which is laid out the same way
+static void background_copy_row(uint8_t *to, const uint8_t *from, int x0, int x1) {
+#if defined(PBL_BW)
+    uint8_t head = (uint8_t)(0xFF << (x0 % 8));
+    uint8_t tail = (uint8_t)(0xFF >> (7 - x1 % 8));
+    int first = x0 / 8;
+    int last = x1 / 8;
+    if (first == last) {
+        head &= tail;
+    }
+    to[first] = (to[first] & ~head) | (from[first] & head);
+    if (first == last) return;
+    if (last - first > 1) {
+        memcpy(to + first + 1, from + first + 1, last - first - 1);
+    }
+    to[last] = (to[last] & ~tail) | (from[last] & tail);
+#else
+    memcpy(to + x0, from + x0, x1 - x0 + 1);
+#endif
+}
+
+// Draw the background layer over black in its band of the screen and keep
+// a copy. Whatever else was in the band is gone afterwards.
+static void background_build(GContext *ctx) {
+    s_background_valid = true;
+    if (!BACKGROUND_CACHE || !FRAMEBUFFER_ACCESS) return;
+    
+    if (!s_background) {
+        // Deep enough for the seahorse and the clam fully open; neither moves
+        GRect seahorse = seahorse_bounds(entity_pos(ENTITY_SEAHORSE));
+        GRect clam = clam_bounds(entity_pos(ENTITY_CLAM), CLAM_OPEN_POSES - 1);
+        int top = seahorse.origin.y < clam.origin.y ? seahorse.origin.y : clam.origin.y;
+        if (top < 0) top = 0;
+        if (top >= s_scene.height) return;
+        s_background_rect = GRect(0, top, s_scene.width, s_scene.height - top);
+        s_background = gbitmap_create_blank(s_background_rect.size,
+                                            PBL_IF_BW_ELSE(GBitmapFormat1Bit, GBitmapFormat8Bit));
+        if (!s_background) {
+            APP_LOG(APP_LOG_LEVEL_WARNING, "Out of memory for the background");
+            return;
+        }
+    }
+    
+    framebuffer_release(ctx);
     graphics_context_set_fill_color(ctx, GColorBlack);
-    GRect bounds = layer_get_bounds(layer);
-    graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+    graphics_fill_rect(ctx, s_background_rect, 0, GCornerNone);
+    uint8_t flags[(ENTITY_COUNT + 7) / 8] = {0};
+    flag_all_slots(flags, true);
+    draw_slots(ctx, flags);
+    framebuffer_release(ctx);
+    
+    if (!framebuffer_acquire(ctx)) {
+        gbitmap_destroy(s_background);
+        s_background = NULL;
+        return;
+    }
+    uint8_t *data = gbitmap_get_data(s_background);
+    uint16_t stride = gbitmap_get_bytes_per_row(s_background);
+    for (int y = 0; y < s_background_rect.size.h; y++) {
+        int screen_y = s_background_rect.origin.y + y;
+        if (screen_y >= s_framebuffer_height) break;
+        GBitmapDataRowInfo row = gbitmap_get_data_row_info(s_framebuffer, screen_y);
+        if (row.min_x > row.max_x) continue;
+        background_copy_row(data + y * stride, row.data, row.min_x, row.max_x);
+    }
+    framebuffer_release(ctx);
+}
+
+static void background_destroy(void) {
+    if (s_background) {
+        gbitmap_destroy(s_background);
+        s_background = NULL;
+    }
+    s_background_valid = false;
+}
+
+// Clear rect back to the background: black, and the cached band where it
+// has one. The fill color must be black.
+static void background_clear(GContext *ctx, GRect rect) {
+    GRect band = rect;
+    if (s_background) grect_clip(&band, &s_background_rect);
+    if (!s_background || rect_is_empty(band)) {
+        framebuffer_release(ctx);
+        graphics_fill_rect(ctx, rect, 0, GCornerNone);
+        return;
+    }
     
-    // Draw seaweed first (background)
-    for (int i = 0; i < MAX_SEAWEED; i++) {
-        draw_seaweed(ctx, &s_seaweed[i]);
+    // The band runs to the bottom of the screen, so only the part above it is black
+    if (rect.origin.y < band.origin.y) {
+        framebuffer_release(ctx);
+        graphics_fill_rect(ctx, GRect(rect.origin.x, rect.origin.y, rect.size.w, band.origin.y - rect.origin.y),
+                           0, GCornerNone);
     }
+    if (!framebuffer_acquire(ctx)) return;
     
-    // Draw clam at the very bottom
-    draw_clam(ctx, &s_clam);
+    const uint8_t *data = gbitmap_get_data(s_background);
+    uint16_t stride = gbitmap_get_bytes_per_row(s_background);
+    for (int y = band.origin.y; y < band.origin.y + band.size.h && y < s_framebuffer_height; y++) {
+        GBitmapDataRowInfo row = gbitmap_get_data_row_info(s_framebuffer, y);
+        int x0 = band.origin.x > row.min_x ? band.origin.x : row.min_x;
+        int x1 = band.origin.x + band.size.w - 1 < row.max_x ? band.origin.x + band.size.w - 1 : row.max_x;
+        if (x0 > x1) continue;
+        background_copy_row(row.data, data + (y - s_background_rect.origin.y) * stride, x0, x1);
+    }
+}
+
+// Add an area to the damage list, merging it into a rect it overlaps
+static void damage_add(GRect rect) {
+    if (s_obstructed) grect_clip(&rect, &s_visible_bounds);
+    if (rect_is_empty(rect)) return;
     
-    // Draw crab at the bottom
-    draw_crab(ctx, &s_crab);
+    for (int i = 0; i < s_damage_count; i++) {
+        if (rect_intersects(s_damage[i], rect)) {
+            s_damage[i] = rect_union(s_damage[i], rect);
+            return;
+        }
+    }
     
-    // Draw plankton
-    for (int i = 0; i < MAX_PLANKTON; i++) {
-        draw_plankton(ctx, &s_plankton[i]);
+    if (s_damage_count < MAX_DAMAGE_RECTS) {
+        s_damage[s_damage_count++] = rect;
+        return;
     }
     
-    // Draw turtle
-    for (int i = 0; i < MAX_TURTLES; i++) {
-        draw_turtle(ctx, &s_turtles[i]);
+    // Out of rects: grow whichever one gets the least bigger
+    int best = 0;
+    int best_growth = INT32_MAX;
+    for (int i = 0; i < s_damage_count; i++) {
+        GRect merged = rect_union(s_damage[i], rect);
+        int growth = merged.size.w * merged.size.h - s_damage[i].size.w * s_damage[i].size.h;
+        if (growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    s_damage[best] = rect_union(s_damage[best], rect);
+}
+
+static bool damage_intersects(GRect rect) {
+    for (int i = 0; i < s_damage_count; i++) {
+        if (rect_intersects(s_damage[i], rect)) return true;
     }
+    return false;
+}
+
+// Draw the aquarium, repainting only what changed since the last frame
+static void canvas_draw(Layer *layer, GContext *ctx) {
+    GRect bounds = layer_get_bounds(layer);
     
-    // Draw jellyfish
-    for (int i = 0; i < MAX_JELLYFISH; i++) {
-        draw_jellyfish(ctx, &s_jellyfish[i]);
+    if (!s_sprites_built) {
+        sprite_cache_build(ctx, bounds);
     }
     
-    // Draw seahorse
-    draw_seahorse(ctx, &s_seahorse);
+    // Damage every slot whose bounds or appearance changed, old area and new
+    s_damage_count = 0;
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        // Off the canvas, under system UI or in a round display's corners:
+        // not drawn, and nothing to work out about how it would look
+        DrawSlot state = { .bounds = GRectZero, .key = 0 };
+        if (!entity_in_view(i)) {
+            if (entity_active(i)) s_culled_draws++;
+        } else {
+            state = slot_state(i);
+            if (!rect_intersects(state.bounds, s_visible_bounds) || !scene_rect_visible(state.bounds)) {
+                state.bounds = GRectZero;
+            }
+        }
+        DrawSlot *last = &s_draw_slots[i];
+        if (state.key != last->key || !grect_equal(&state.bounds, &last->bounds)) {
+            damage_add(last->bounds);
+            damage_add(state.bounds);
+            *last = state;
+            if (slot_in_background(i)) s_background_valid = false;
+        }
+    }
     
-    // Draw fish (foreground)
-    for (int i = 0; i < MAX_FISH + MAX_BIG_FISH; i++) {
-        draw_fish(ctx, &s_fish[i]);
+    // Rebuilding the background wipes its band, so all of it gets redrawn
+    if (!s_background_valid) {
+        background_build(ctx);
+        if (s_background) damage_add(s_background_rect);
+    }
+    
+    // Anything overlapping the damage has to be redrawn, which in turn
+    // damages its whole area; repeat until no more slots get pulled in.
+    // A cached background is restored by clearing instead, unless something
+    // before it is redrawn over it.
+    uint8_t redraw[(ENTITY_COUNT + 7) / 8] = {0};
+    bool grew = true;
+    while (grew && !s_full_redraw) {
+        grew = false;
+        for (int i = 0; i < ENTITY_COUNT; i++) {
+            if (slot_flagged(redraw, i)) continue;
+            bool cached = s_background && slot_in_background(i);
+            if (cached ? background_buried(i, redraw) : damage_intersects(s_draw_slots[i].bounds)) {
+                slot_flag(redraw, i);
+                damage_add(s_draw_slots[i].bounds);
+                grew = true;
+            }
+        }
     }
     
-    // Draw bubbles
-    for (int i = 0; i < MAX_BUBBLES; i++) {
-        draw_bubble(ctx, &s_bubbles[i]);
+    // Fall back to a full clear when most of the screen is damaged anyway
+    GRect visible_bounds = s_obstructed ? s_visible_bounds : bounds;
+    int damaged_area = 0;
+    for (int i = 0; i < s_damage_count; i++) {
+        GRect visible = s_damage[i];
+        grect_clip(&visible, &visible_bounds);
+        damaged_area += visible.size.w * visible.size.h;
+    }
+    if (damaged_area * 100 > visible_bounds.size.w * visible_bounds.size.h * FULL_REDRAW_PERCENT) {
+        s_full_redraw = true;
     }
     
-    // Draw octopus
-    draw_octopus(ctx, &s_octopus);
+    // Clear (black for B&W displays) and redraw back to front
+    graphics_context_set_fill_color(ctx, GColorBlack);
+    if (s_full_redraw) {
+        background_clear(ctx, visible_bounds);
+        uint8_t all[(ENTITY_COUNT + 7) / 8] = {0};
+        flag_all_slots(all, false);
+        batch_begin();
+        draw_slots(ctx, all);
+        batch_end(ctx);
+        framebuffer_release(ctx);
+        s_full_redraw = false;
+        return;
+    }
     
-    // Draw shark on top of everything (it's the apex predator!)
-    draw_shark(ctx, &s_shark);
+    for (int i = 0; i < s_damage_count; i++) {
+        background_clear(ctx, s_damage[i]);
+    }
+    batch_begin();
+    draw_slots(ctx, redraw);
+    batch_end(ctx);
+    framebuffer_release(ctx);
+}
+
+// Update canvas layer, timing the render for the frame governor
+static void canvas_update_proc(Layer *layer, GContext *ctx) {
+    int64_t start = clock_now_ms();
+    canvas_draw(layer, ctx);
+    s_governor.render_ms = clock_now_ms() - start;
 }
 
 // Battery layer update proc
@@ -943,170 +2884,144 @@ static void battery_update_proc(Layer *layer, GContext *ctx) {
 // Animation update
 static void animation_update(void) {
     // Update fish positions and check for fish being eaten
-    for (int i = 0; i < MAX_FISH + MAX_BIG_FISH; i++) {
-        if (!s_fish[i].active) continue;
+    for (int id = ENTITY_FISH; id < ENTITY_BUBBLE; id++) {
+        if (!entity_active(id)) continue;
         
-        s_fish[i].pos.x += s_fish[i].direction * s_fish[i].speed;
+        s_entities.x[id] += entity_direction(id) * entity_speed(id);
         
         // Reset fish if it swims off screen
-        if ((s_fish[i].direction == 1 && s_fish[i].pos.x > 144) ||  // Use screen width
-            (s_fish[i].direction == -1 && s_fish[i].pos.x < -10)) {
-            if (s_fish[i].size == 1) {
-                init_fish(&s_fish[i], 1);  // Reinitialize small fish
-            } else {
-                init_fish(&s_fish[i], 2);  // Reinitialize big fish
-            }
+        if ((entity_direction(id) == 1 && s_entities.x[id] > scene_row_right(s_entities.y[id])) ||
+            (entity_direction(id) == -1 && s_entities.x[id] < scene_row_left(s_entities.y[id]) - 10)) {
+            init_fish(id);  // Reinitialize, same size as before
         }
     }
     
-    // Update spatial grid
-    update_spatial_grid();
+    // Bin the fish for predators to look up
+    broadphase_build();
     
-    // Check for fish collisions using grid for optimization
-    for (int i = 0; i < MAX_FISH + MAX_BIG_FISH; i++) {
-        // Only check big fish as predators
-        if (!s_fish[i].active || s_fish[i].size <= 1) continue;
+    // Big fish eat the small fish they touch
+    for (int i = ENTITY_BIG_FISH; i < ENTITY_BUBBLE; i++) {
+        if (!entity_active(i)) continue;
         
-        int cell = s_fish[i].grid_cell;
-        
-        // Ensure valid cell before checking
-        if (cell < 0 || cell >= GRID_CELL_COUNT) continue;
-        
-        // Check fish in same cell and adjacent cells
-        for (int cell_y = -1; cell_y <= 1; cell_y++) {
-            for (int cell_x = -1; cell_x <= 1; cell_x++) {
-                int target_cell_x = (cell % GRID_WIDTH) + cell_x;
-                int target_cell_y = (cell / GRID_WIDTH) + cell_y;
-                
-                // Skip if outside grid
-                if (target_cell_x < 0 || target_cell_x >= GRID_WIDTH ||
-                    target_cell_y < 0 || target_cell_y >= GRID_HEIGHT) {
-                    continue;
-                }
-                
-                int target_cell = target_cell_y * GRID_WIDTH + target_cell_x;
-                
-                // Bounds check
-                if (target_cell < 0 || target_cell >= GRID_CELL_COUNT) continue;
-                
-                // Check all fish in this cell with strict bounds checking
-                for (int k = 0; k < s_fish_grid_counts[target_cell]; k++) {
-                    // Double-check we're accessing a valid fish
-                    if (k >= MAX_FISH + MAX_BIG_FISH) break;
-                    
-                    int j = s_fish_in_grid[target_cell][k];
-                    
-                    // Strict bounds check for array access
-                    if (j < 0 || j >= MAX_FISH + MAX_BIG_FISH) continue;
-                    
-                    // Only check small fish that are active
-                    if (j < MAX_FISH && s_fish[j].active && s_fish[j].size == 1) {
-                        if (check_collision(s_fish[i].pos, 7, s_fish[j].pos, 4)) {
-                            s_fish[j].active = false;  // Small fish gets eaten
-                            
-                            // Create bubbles for eating event - limit to available bubbles
-                            int bubbles_created = 0;
-                            for (int b = 0; b < MAX_BUBBLES && bubbles_created < 3; b++) {
-                                if (!s_bubbles[b].active) {
-                                    s_bubbles[b].pos = s_fish[j].pos;
-                                    s_bubbles[b].size = random_in_range(1, 2);
-                                    s_bubbles[b].speed = random_in_range(1, 2);
-                                    s_bubbles[b].active = true;
-                                    bubbles_created++;
-                                }
-                            }
-                        }
-                    }
+        uint8_t prey[BROADPHASE_END - BROADPHASE_FIRST];
+        GRect reach = reach_around(entity_pos(i), 7 + 4, 7 + 4);  // Radius of both
+        int prey_count = broadphase_query(reach, CATEGORY_MASK(CATEGORY_SMALL_FISH), prey, ARRAY_LENGTH(prey));
+        for (int k = 0; k < prey_count; k++) {
+            int j = prey[k];
+            if (!entity_active(j) || !check_collision(entity_pos(i), 7, entity_pos(j), 4)) continue;
+            
+            entity_set_active(j, false);  // Small fish gets eaten
+            
+            // Create bubbles for eating event - limit to available bubbles
+            int bubbles_created = 0;
+            for (int b = ENTITY_BUBBLE; b < ENTITY_OCTOPUS && bubbles_created < 3; b++) {
+                if (!entity_active(b)) {
+                    entity_set_pos(b, entity_pos(j));
+                    entity_set_size(b, random_in_range(1, 2));
+                    entity_set_speed(b, random_in_range(1, 2));
+                    entity_set_active(b, true);
+                    bubbles_created++;
                 }
             }
         }
     }
     
     // Check for respawning fish - limit checks to reduce CPU usage
-    for (int i = 0; i < MAX_FISH; i++) {
-        if (!s_fish[i].active && (random_in_range(0, 99) < 2)) { // 2% chance instead of complex comparison
-            init_fish(&s_fish[i], 1);  // Reinitialize with size 1 (small fish)
+    bool fish_respawned = false;
+    for (int id = ENTITY_FISH; id < ENTITY_BIG_FISH; id++) {
+        if (!entity_active(id) && (random_in_range(0, 99) < 2)) { // 2% chance instead of complex comparison
+            init_fish(id);  // Reinitialize as a small fish
+            fish_respawned = true;
         }
     }
     
     // Update seaweed animation with overflow protection
-    for (int i = 0; i < MAX_SEAWEED; i++) {
-        s_seaweed[i].offset = (s_seaweed[i].offset + s_seaweed[i].speed * 100) % TRIG_MAX_ANGLE;
+    for (int id = ENTITY_SEAWEED; id < ENTITY_CLAM; id++) {
+        if (!slot_visible(id)) continue;  // Sways again once uncovered
+        s_entities.phase[id] = (s_entities.phase[id] + entity_speed(id) * 100) % TRIG_MAX_ANGLE;
     }
     
     // Update bubbles
-    for (int i = 0; i < MAX_BUBBLES; i++) {
-        if (s_bubbles[i].active) {
-            s_bubbles[i].pos.y -= s_bubbles[i].speed;
+    for (int id = ENTITY_BUBBLE; id < ENTITY_OCTOPUS; id++) {
+        if (entity_active(id)) {
+            s_entities.y[id] -= entity_speed(id);
             
             // Slight x wobble
             if (random_in_range(0, 2) == 0) {
-                s_bubbles[i].pos.x += random_in_range(-1, 1);
+                s_entities.x[id] += random_in_range(-1, 1);
             }
             
             // Remove bubble when it reaches the top
-            if (s_bubbles[i].pos.y < 0) {
-                s_bubbles[i].active = false;
+            if (s_entities.y[id] < 0) {
+                entity_set_active(id, false);
             }
         } else if (random_in_range(0, 199) < 2) {  // Reduced chance to 1% from 2%
-            init_bubble(&s_bubbles[i]);
+            init_bubble(id);
         }
     }
     
     // Update plankton
-    for (int i = 0; i < MAX_PLANKTON; i++) {
-        if (s_plankton[i].active) {
-            // Random movement for plankton
-            if (random_in_range(0, 3) == 0) {
-                s_plankton[i].pos.x += random_in_range(-1, 1);
-                s_plankton[i].pos.y += random_in_range(-1, 1);
+    for (int id = ENTITY_PLANKTON; id < ENTITY_TURTLE; id++) {
+        if (entity_active(id)) {
+            // Random movement for plankton, while it can be seen
+            if (slot_visible(id) && random_in_range(0, 3) == 0) {
+                s_entities.x[id] += random_in_range(-1, 1);
+                s_entities.y[id] += random_in_range(-1, 1);
             }
             
             // Keep plankton in bounds
-            if (s_plankton[i].pos.x < 0) s_plankton[i].pos.x = 0;
-            if (s_plankton[i].pos.x > 144) s_plankton[i].pos.x = 144;
-            if (s_plankton[i].pos.y < 0) s_plankton[i].pos.y = 0;
-            if (s_plankton[i].pos.y > 168) s_plankton[i].pos.y = 168;
+            if (s_entities.x[id] < 0) s_entities.x[id] = 0;
+            if (s_entities.x[id] > s_scene.width) s_entities.x[id] = s_scene.width;
+            if (s_entities.y[id] < 0) s_entities.y[id] = 0;
+            if (s_entities.y[id] > s_scene.height) s_entities.y[id] = s_scene.height;
         } else if (random_in_range(0, 199) < 3) {  // Reduced chance to 1.5%
-            init_plankton(&s_plankton[i]);
+            init_plankton(id);
         }
     }
     
     // Update turtle
-    for (int i = 0; i < MAX_TURTLES; i++) {
-        update_turtle(&s_turtles[i]);
+    for (int id = ENTITY_TURTLE; id < ENTITY_JELLYFISH; id++) {
+        update_turtle(id);
     }
     
     // Update jellyfish
-    for (int i = 0; i < MAX_JELLYFISH; i++) {
-        update_jellyfish(&s_jellyfish[i]);
+    for (int id = ENTITY_JELLYFISH; id < ENTITY_SEAHORSE; id++) {
+        update_jellyfish(id);
     }
     
     // Update octopus
-    update_octopus(&s_octopus);
+    update_octopus();
     
     // Update shark
-    if (s_shark.active) {
+    if (entity_active(ENTITY_SHARK)) {
         // Move shark
-        s_shark.pos.x += s_shark.direction * s_shark.speed;
+        s_entities.x[ENTITY_SHARK] += entity_direction(ENTITY_SHARK) * entity_speed(ENTITY_SHARK);
+        GPoint shark_pos = entity_pos(ENTITY_SHARK);
         
-        // Check for shark eating fish - limit checks per frame
+        // Check for shark eating fish of either size - limit checks per frame
+        if (fish_respawned) broadphase_build();  // Newly spawned fish can be caught too
+        uint8_t prey[BROADPHASE_END - BROADPHASE_FIRST];
+        int prey_count = broadphase_query(reach_around(shark_pos, 19, 11),
+                                          CATEGORY_MASK(CATEGORY_SMALL_FISH) | CATEGORY_MASK(CATEGORY_BIG_FISH),
+                                          prey, ARRAY_LENGTH(prey));
+        broadphase_sort(prey, prey_count);  // Lowest ids first, as before the cap
         int fish_eaten = 0;
-        for (int i = 0; i < MAX_FISH + MAX_BIG_FISH && fish_eaten < 2; i++) {
-            if (s_fish[i].active) {
-                if (abs(s_shark.pos.x - s_fish[i].pos.x) < 20 && 
-                    abs(s_shark.pos.y - s_fish[i].pos.y) < 12) {
-                    s_fish[i].active = false;  // Fish gets eaten
+        for (int k = 0; k < prey_count && fish_eaten < 2; k++) {
+            int i = prey[k];
+            if (entity_active(i)) {
+                if (abs(shark_pos.x - s_entities.x[i]) < 20 && 
+                    abs(shark_pos.y - s_entities.y[i]) < 12) {
+                    entity_set_active(i, false);  // Fish gets eaten
                     fish_eaten++;
                     
                     // Create bubbles to mark the eating event - limit bubbles
                     int bubbles_created = 0;
-                    for (int b = 0; b < MAX_BUBBLES && bubbles_created < 3; b++) {
-                        if (!s_bubbles[b].active) {
-                            s_bubbles[b].pos = s_fish[i].pos;
-                            s_bubbles[b].size = random_in_range(1, 3);
-                            s_bubbles[b].speed = random_in_range(1, 3);
-                            s_bubbles[b].active = true;
+                    for (int b = ENTITY_BUBBLE; b < ENTITY_OCTOPUS && bubbles_created < 3; b++) {
+                        if (!entity_active(b)) {
+                            entity_set_pos(b, entity_pos(i));
+                            entity_set_size(b, random_in_range(1, 3));
+                            entity_set_speed(b, random_in_range(1, 3));
+                            entity_set_active(b, true);
                             bubbles_created++;
                         }
                     }
@@ -1115,29 +3030,27 @@ static void animation_update(void) {
         }
         
         // Remove shark if it swims off screen
-        if ((s_shark.direction == 1 && s_shark.pos.x > 174) ||
-            (s_shark.direction == -1 && s_shark.pos.x < -30)) {
-            s_shark.active = false;
-            s_shark.timer = random_in_range(200, 500);  // Reduced cooldown before next appearance
+        if ((entity_direction(ENTITY_SHARK) == 1 && shark_pos.x > scene_row_right(shark_pos.y) + 30) ||
+            (entity_direction(ENTITY_SHARK) == -1 && shark_pos.x < scene_row_left(shark_pos.y) - 30)) {
+            entity_set_active(ENTITY_SHARK, false);
+            s_shark_timer = random_in_range(200, 500);  // Reduced cooldown before next appearance
         }
     } else {
         // Countdown to shark appearance
-        s_shark.timer--;
-        if (s_shark.timer <= 0) {
+        s_shark_timer--;
+        if (s_shark_timer <= 0) {
             // Time for shark to appear!
-            init_shark(&s_shark);
-            s_shark.active = true;
+            init_shark();
+            entity_set_active(ENTITY_SHARK, true);
         }
     }
     
     // Update seahorse - only animate, never disappear
-    update_seahorse(&s_seahorse);
-    
-    // Update crab
-    update_crab(&s_crab);
+    update_seahorse();
     
-    // Update clam
-    update_clam(&s_clam);
+    // Update crab and clam; on the sea floor they're the first to be covered
+    if (slot_visible(ENTITY_CRAB)) update_crab();
+    if (slot_visible(ENTITY_CLAM)) update_clam();
     
     if (s_canvas_layer) {
         layer_mark_dirty(s_canvas_layer);
@@ -1166,24 +3079,92 @@ static void update_time(void) {
     static char s_date_buffer[24];
     strftime(s_date_buffer, sizeof(s_date_buffer), "%a, %b %d", tick_time);  // Added day of week
     text_layer_set_text(s_date_layer, s_date_buffer);
+    
+    // Clear the old text out of the canvas
+    request_full_redraw();
 }
 
-// Time tick handler
-static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
-    update_time();
+// Start simulating from now
+static void simulation_reset(void) {
+    s_sim_time_ms = clock_now_ms();
 }
 
-// Animation timer callback
-static void animation_timer_callback(void *data) {
-    // First update the animation
-    animation_update();
+// Run as many fixed steps as wall time has moved on since the last call
+static void simulation_advance(void) {
+    int64_t now = clock_now_ms();
+    if (now < s_sim_time_ms) {
+        // The clock was set back; carry on from here
+        s_sim_time_ms = now;
+        return;
+    }
     
-    // Determine next interval based on battery level
-    uint32_t next_interval = (s_battery_level <= LOW_BATTERY_THRESHOLD && !s_is_charging) ? 
-                             ANIMATION_INTERVAL_LOW_POWER : ANIMATION_INTERVAL;
+    int64_t steps = (now - s_sim_time_ms) / SIM_STEP_MS;
+    if (steps > MAX_CATCHUP_STEPS) {
+        // Far behind, e.g. after a long stall: drop the backlog rather than fast-forward
+        s_sim_time_ms += (steps - MAX_CATCHUP_STEPS) * SIM_STEP_MS;
+        steps = MAX_CATCHUP_STEPS;
+    }
+    
+    for (int64_t i = 0; i < steps; i++) {
+        animation_update();
+        s_sim_time_ms += SIM_STEP_MS;
+    }
+}
+
+// Frame-rate governor
+
+// Interval the battery state asks for
+static int battery_frame_interval(void) {
+    if (s_is_charging || s_battery_level > GOOD_BATTERY_THRESHOLD) return SIM_STEP_MS;
+    if (s_battery_level > LOW_BATTERY_THRESHOLD) return 100;
+    if (s_battery_level > CRITICAL_BATTERY_THRESHOLD) return 250;
+    return 1000;
+}
+
+// Little is moving: no shark and only a few fish
+static bool scene_is_calm(void) {
+    if (entity_active(ENTITY_SHARK)) return false;
     
-    // Simply register the next timer - no complex retry logic needed
-    s_animation_timer = app_timer_register(next_interval, animation_timer_callback, NULL);
+    int active_fish = 0;
+    for (int id = ENTITY_FISH; id < ENTITY_BUBBLE; id++) {
+        if (entity_active(id)) active_fish++;
+    }
+    return active_fish <= CALM_FISH_COUNT;
+}
+
+// Fold the last frame's cost into the average and pick the next interval
+static void frame_governor_update(void) {
+    int sample_x16 = (s_governor.update_ms + s_governor.render_ms) * 16;
+    s_governor.cost_x16 += (sample_x16 - s_governor.cost_x16) / 8;
+    s_governor.cost_ms = s_governor.cost_x16 / 16;
+    
+    int wanted = battery_frame_interval();
+    if (scene_is_calm()) wanted *= 2;
+    int affordable = s_governor.cost_ms * 100 / FRAME_BUDGET_PERCENT;
+    if (affordable > wanted) wanted = affordable;
+    if (wanted < SIM_STEP_MS) wanted = SIM_STEP_MS;
+    
+    // Shortest rung at least as long as wanted, or the longest there is
+    int interval = s_frame_ladder[FRAME_LADDER_RUNGS - 1];
+    for (int i = 0; i < FRAME_LADDER_RUNGS; i++) {
+        if (s_frame_ladder[i] >= wanted) {
+            interval = s_frame_ladder[i];
+            break;
+        }
+    }
+    
+    if (interval != s_governor.interval_ms) {
+        APP_LOG(APP_LOG_LEVEL_DEBUG, "Frame interval %d ms (cost %d ms, battery %d%%)",
+                interval, s_governor.cost_ms, s_battery_level);
+        s_governor.interval_ms = interval;
+    }
+}
+
+static void animation_timer_callback(void *data);
+
+// Queue the next frame, with one retry at a longer interval
+static void animation_schedule(uint32_t interval_ms) {
+    s_animation_timer = app_timer_register(interval_ms, animation_timer_callback, NULL);
     
     // If for some reason the timer couldn't be registered, try one more time with a fallback interval
     if (!s_animation_timer) {
@@ -1192,27 +3173,156 @@ static void animation_timer_callback(void *data) {
     }
 }
 
+// How long a burst lasts from its last trigger; 0 for as long as the face is shown
+static int32_t animation_burst_ms(void) {
+    return s_settings.mode == ANIMATION_BURSTS ? s_settings.burst_ms : IDLE_TIMEOUT_MS;
+}
+
+// Start a burst, or extend the running one. Triggers during a cooldown are dropped.
+static void animation_trigger(void) {
+    if (!s_canvas_layer || !s_in_focus) return;  // Not loaded, or covered
+    
+    int64_t now = clock_now_ms();
+    if (s_animation_state == ANIMATION_COOLDOWN) {
+        if (now < s_animation_until_ms) return;
+        s_animation_state = ANIMATION_IDLE;
+    }
+    
+    s_animation_until_ms = now + animation_burst_ms();
+    if (s_animation_state == ANIMATION_BURST) return;
+    
+    // Carry on from the frozen frame instead of catching up on the time in between
+    s_animation_state = ANIMATION_BURST;
+    simulation_reset();
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Animation burst started");
+    animation_schedule(ANIMATION_INTERVAL);
+}
+
+// The burst has run its course: keep the last frame and stop the timer
+static void animation_end_burst(void) {
+    s_animation_timer = NULL;  // Already fired, nothing to cancel
+    if (s_settings.mode == ANIMATION_BURSTS && s_settings.cooldown_ms > 0) {
+        s_animation_state = ANIMATION_COOLDOWN;
+        s_animation_until_ms = clock_now_ms() + s_settings.cooldown_ms;
+    } else {
+        s_animation_state = ANIMATION_IDLE;
+    }
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Animation stopped");
+}
+
+// Animation timer callback
+static void animation_timer_callback(void *data) {
+    if (animation_burst_ms() > 0 && clock_now_ms() >= s_animation_until_ms) {
+        animation_end_burst();
+        return;
+    }
+    
+    // Catch the simulation up with the wall clock; this frame renders the result
+    int64_t start = clock_now_ms();
+    simulation_advance();
+    s_governor.update_ms = clock_now_ms() - start;
+    
+    frame_governor_update();
+    animation_schedule(s_governor.interval_ms);
+}
+
+// Time tick handler
+static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
+    update_time();
+    if (s_settings.mode == ANIMATION_BURSTS) animation_trigger();
+}
+
+// Tap or wrist flick: the watch is being looked at
+static void accel_tap_handler(AccelAxisType axis, int32_t direction) {
+    animation_trigger();
+}
+
+// A notification or another window covers the face while we're out of
+// focus, so animating would only burn battery
+static void app_focus_handler(bool in_focus) {
+    s_in_focus = in_focus;
+    if (in_focus) {
+        // Whatever covered us has overwritten the framebuffer
+        request_full_redraw();
+        animation_trigger();
+        return;
+    }
+    
+    if (s_animation_timer) {
+        app_timer_cancel(s_animation_timer);
+        s_animation_timer = NULL;
+    }
+    s_animation_state = ANIMATION_IDLE;
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Out of focus, animation stopped");
+}
+
+// Track the part of the canvas the system UI leaves visible
+static void visible_area_update(void) {
+    GRect bounds = layer_get_bounds(s_canvas_layer);
+#if PBL_API_EXISTS(layer_get_unobstructed_bounds)
+    s_visible_bounds = layer_get_unobstructed_bounds(s_canvas_layer);
+    s_obstructed = !grect_equal(&s_visible_bounds, &bounds);
+#else
+    // Firmware 3.x has no Quick View, so nothing ever covers the canvas
+    s_visible_bounds = bounds;
+    s_obstructed = false;
+#endif
+}
+
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+static void unobstructed_did_change(void *context) {
+    if (!s_canvas_layer) return;
+    visible_area_update();
+    
+    // Uncovered areas were neither drawn nor kept up to date
+    request_full_redraw();
+}
+#endif
+
+// Read the animation settings, falling back to the defaults for anything
+// missing or out of range
+static void animation_settings_load(void) {
+    if (persist_exists(PERSIST_KEY_ANIMATION_MODE)) {
+        int32_t mode = persist_read_int(PERSIST_KEY_ANIMATION_MODE);
+        if (mode == ANIMATION_CONTINUOUS || mode == ANIMATION_BURSTS) s_settings.mode = mode;
+    }
+    if (persist_exists(PERSIST_KEY_BURST_MS)) {
+        int32_t burst_ms = persist_read_int(PERSIST_KEY_BURST_MS);
+        if (burst_ms >= MIN_BURST_MS && burst_ms <= MAX_BURST_MS) s_settings.burst_ms = burst_ms;
+    }
+    if (persist_exists(PERSIST_KEY_COOLDOWN_MS)) {
+        int32_t cooldown_ms = persist_read_int(PERSIST_KEY_COOLDOWN_MS);
+        if (cooldown_ms >= 0 && cooldown_ms <= MAX_COOLDOWN_MS) s_settings.cooldown_ms = cooldown_ms;
+    }
+}
+
+static void animation_settings_save(void) {
+    persist_write_int(PERSIST_KEY_ANIMATION_MODE, s_settings.mode);
+    persist_write_int(PERSIST_KEY_BURST_MS, s_settings.burst_ms);
+    persist_write_int(PERSIST_KEY_COOLDOWN_MS, s_settings.cooldown_ms);
+}
+
 // Update crab animation
-static void update_crab(Crab *crab) {
+static void update_crab(void) {
     // Move side to side
-    crab->pos.x += crab->direction * crab->speed;
+    s_entities.x[ENTITY_CRAB] += entity_direction(ENTITY_CRAB) * entity_speed(ENTITY_CRAB);
     
     // Animate claws
-    crab->claw_state = (crab->claw_state + 1) % 20;
+    s_entities.phase[ENTITY_CRAB] = (s_entities.phase[ENTITY_CRAB] + 1) % 20;
     
     // Reverse direction at screen edges
-    if (crab->pos.x <= 15 || crab->pos.x >= 130) {
-        crab->direction *= -1;
+    if (s_entities.x[ENTITY_CRAB] <= scene_x(15) || s_entities.x[ENTITY_CRAB] >= s_scene.width - 14) {
+        entity_set_direction(ENTITY_CRAB, -entity_direction(ENTITY_CRAB));
     }
 }
 
 // Update clam animation
-static void update_clam(Clam *clam) {
+static void update_clam(void) {
     // Occasionally open and close
-    if (clam->open_state > 0) {
-        clam->open_state--;
+    if (s_entities.phase[ENTITY_CLAM] > 0) {
+        s_entities.phase[ENTITY_CLAM]--;
     } else if (random_in_range(0, 399) == 0) {  // Rare opening (every ~20 seconds)
-        clam->open_state = 40;  // Stay open for 2 seconds
+        s_entities.phase[ENTITY_CLAM] = 40;  // Stay open for 2 seconds
     }
 }
 
@@ -1221,61 +3331,66 @@ static void battery_callback(BatteryChargeState charge_state) {
     s_battery_level = charge_state.charge_percent;
     s_is_charging = charge_state.is_charging;
     
-    // Request redraw of battery indicator
+    // Request redraw of battery indicator; the canvas underneath has to be
+    // repainted too, since a shorter bar leaves stale pixels behind
     if (s_battery_layer) {
         layer_mark_dirty(s_battery_layer);
     }
+    request_full_redraw();
 }
 
 // Update turtle
-static void update_turtle(Turtle *turtle) {
-    turtle->pos.x += turtle->direction * turtle->speed;
+static void update_turtle(int id) {
+    s_entities.x[id] += entity_direction(id) * entity_speed(id);
     // Apply modulo immediately to prevent overflow
-    turtle->animation_offset = (turtle->animation_offset + turtle->speed * 200) % TRIG_MAX_ANGLE;
+    s_entities.phase[id] = (s_entities.phase[id] + entity_speed(id) * 200) % TRIG_MAX_ANGLE;
     
     // Reset turtle if it swims off screen
-    if ((turtle->direction == 1 && turtle->pos.x > 144) ||
-        (turtle->direction == -1 && turtle->pos.x < -15)) {
-        init_turtle(turtle);
+    if ((entity_direction(id) == 1 && s_entities.x[id] > scene_row_right(s_entities.y[id])) ||
+        (entity_direction(id) == -1 && s_entities.x[id] < scene_row_left(s_entities.y[id]) - 15)) {
+        init_turtle(id);
     }
 }
 
 // Update jellyfish
-static void update_jellyfish(Jellyfish *jellyfish) {
+static void update_jellyfish(int id) {
     // Apply modulo immediately to prevent overflow
-    jellyfish->tentacle_offset = (jellyfish->tentacle_offset + jellyfish->speed * 100) % TRIG_MAX_ANGLE;
+    s_entities.phase[id] = (s_entities.phase[id] + entity_speed(id) * 100) % TRIG_MAX_ANGLE;
     
     // Update pulse animation
-    jellyfish->pulse_state = (jellyfish->pulse_state + 1) % 100;
+    uint8_t *pulse_state = &s_jellyfish_pulse[id - ENTITY_JELLYFISH];
+    *pulse_state = (*pulse_state + 1) % 100;
     
     // Move jellyfish slightly up when pulsing (middle of animation)
-    if (jellyfish->pulse_state == 50) {
-        jellyfish->pos.y -= 2;
-        if (jellyfish->pos.y < 60) jellyfish->pos.y = 60;
+    if (*pulse_state == 50) {
+        s_entities.y[id] -= 2;
+        if (s_entities.y[id] < scene_y(60)) s_entities.y[id] = scene_y(60);
     }
     
     // Random side movement
     if (random_in_range(0, 19) == 0) {
-        jellyfish->pos.x += random_in_range(-1, 1);
+        s_entities.x[id] += random_in_range(-1, 1);
         
         // Keep in bounds
-        if (jellyfish->pos.x < 10) jellyfish->pos.x = 10;
-        if (jellyfish->pos.x > 134) jellyfish->pos.x = 134;
+        if (s_entities.x[id] < 10) s_entities.x[id] = 10;
+        if (s_entities.x[id] > s_scene.width - 10) s_entities.x[id] = s_scene.width - 10;
     }
 }
 
 // Update octopus
-static void update_octopus(Octopus *octopus) {
+static void update_octopus(void) {
+    int16_t *x = &s_entities.x[ENTITY_OCTOPUS];
+    
     // Apply modulo immediately to prevent overflow
-    octopus->tentacle_offset = (octopus->tentacle_offset + octopus->speed * 50) % TRIG_MAX_ANGLE;
+    s_entities.phase[ENTITY_OCTOPUS] = (s_entities.phase[ENTITY_OCTOPUS] + entity_speed(ENTITY_OCTOPUS) * 50) % TRIG_MAX_ANGLE;
     
     // Slow movement for octopus
     if (random_in_range(0, 9) == 0) {
-        octopus->pos.x += random_in_range(-1, 1);
+        *x += random_in_range(-1, 1);
         
         // Keep octopus in bounds
-        if (octopus->pos.x < 10) octopus->pos.x = 10;
-        if (octopus->pos.x > 134) octopus->pos.x = 134;
+        if (*x < 10) *x = 10;
+        if (*x > s_scene.width - 10) *x = s_scene.width - 10;
     }
 }
 
@@ -1289,8 +3404,12 @@ static void main_window_load(Window *window) {
         APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to create canvas layer");
         return;
     }
+    scene_geometry_init(layer_get_bounds(s_canvas_layer));
+    sway_table_build();
     layer_set_update_proc(s_canvas_layer, canvas_update_proc);
+    visible_area_update();
     layer_add_child(window_layer, s_canvas_layer);
+    s_full_redraw = true;  // Nothing of ours is on screen yet
     
     // Create time layer
     GRect time_frame;
@@ -1343,59 +3462,54 @@ static void main_window_load(Window *window) {
     layer_set_update_proc(s_battery_layer, battery_update_proc);
     layer_add_child(window_layer, s_battery_layer);
     
-    // Initialize small fish
-    for (int i = 0; i < MAX_FISH; i++) {
-        init_fish(&s_fish[i], 1);  // Small fish
-    }
-    
-    // Initialize big fish
-    for (int i = MAX_FISH; i < MAX_FISH + MAX_BIG_FISH; i++) {
-        init_fish(&s_fish[i], 2);  // Big fish
+    // Initialize small fish, then big fish
+    for (int id = ENTITY_FISH; id < ENTITY_BUBBLE; id++) {
+        init_fish(id);
     }
     
     // Initialize seaweed
     for (int i = 0; i < MAX_SEAWEED; i++) {
-        init_seaweed(&s_seaweed[i], 20 + (i * 35));
+        init_seaweed(ENTITY_SEAWEED + i, scene_x(20 + (i * 140) / MAX_SEAWEED));
     }
     
     // Initialize bubbles
-    for (int i = 0; i < MAX_BUBBLES; i++) {
-        s_bubbles[i].active = false;  // Start with no bubbles
+    for (int id = ENTITY_BUBBLE; id < ENTITY_OCTOPUS; id++) {
+        entity_set_active(id, false);  // Start with no bubbles
     }
     
     // Initialize plankton
-    for (int i = 0; i < MAX_PLANKTON; i++) {
+    for (int id = ENTITY_PLANKTON; id < ENTITY_TURTLE; id++) {
         if (random_in_range(0, 2) == 0) {  // Start with some plankton
-            init_plankton(&s_plankton[i]);
+            init_plankton(id);
         } else {
-            s_plankton[i].active = false;
+            entity_set_active(id, false);
         }
     }
     
     // Initialize octopus
-    init_octopus(&s_octopus);
+    init_octopus();
     
     // Initialize turtle
-    for (int i = 0; i < MAX_TURTLES; i++) {
-        init_turtle(&s_turtles[i]);
+    for (int id = ENTITY_TURTLE; id < ENTITY_JELLYFISH; id++) {
+        init_turtle(id);
     }
     
     // Initialize jellyfish
-    for (int i = 0; i < MAX_JELLYFISH; i++) {
-        init_jellyfish(&s_jellyfish[i]);
+    for (int id = ENTITY_JELLYFISH; id < ENTITY_SEAHORSE; id++) {
+        init_jellyfish(id);
     }
     
     // Initialize shark
-    init_shark(&s_shark);
+    init_shark();
     
     // Initialize seahorse
-    init_seahorse(&s_seahorse);
+    init_seahorse();
     
     // Initialize crab
-    init_crab(&s_crab);
+    init_crab();
     
     // Initialize clam
-    init_clam(&s_clam);
+    init_clam();
     
     // Create and initialize paths once
     // Fish tail path
@@ -1437,12 +3551,16 @@ static void main_window_load(Window *window) {
     };
     s_shark_fin_path = gpath_create(&shark_fin_info);
     
-    // Start animation timer with error checking
-    s_animation_timer = app_timer_register(ANIMATION_INTERVAL, animation_timer_callback, NULL);
-    if (!s_animation_timer) {
-        // If timer creation fails, try again with longer interval
-        s_animation_timer = app_timer_register(ANIMATION_INTERVAL * 2, animation_timer_callback, NULL);
-    }
+    // Replays recorded paths of any size up to BATCH_PATH_POINTS
+    GPathInfo batch_path_info = {
+        .num_points = BATCH_PATH_POINTS,
+        .points = s_batch_path_points,
+    };
+    s_batch_path = gpath_create(&batch_path_info);
+    
+    // Showing the face starts the first burst
+    s_animation_state = ANIMATION_IDLE;
+    animation_trigger();
     
     // Update time immediately
     update_time();
@@ -1454,6 +3572,7 @@ static void main_window_unload(Window *window) {
         app_timer_cancel(s_animation_timer);
         s_animation_timer = NULL;
     }
+    s_animation_state = ANIMATION_IDLE;
     
     // Clean up path resources
     if (s_fish_tail_path) {
@@ -1486,6 +3605,14 @@ static void main_window_unload(Window *window) {
         s_shark_fin_path = NULL;
     }
     
+    if (s_batch_path) {
+        gpath_destroy(s_batch_path);
+        s_batch_path = NULL;
+    }
+    
+    sprite_cache_destroy();
+    background_destroy();
+    
     if (s_canvas_layer) {
         layer_destroy(s_canvas_layer);
         s_canvas_layer = NULL;
@@ -1508,10 +3635,11 @@ static void main_window_unload(Window *window) {
 }
 
 static void init(void) {
-    srand(time(NULL));  // Initialize random seed
+    random_seed(&s_random, (uint32_t)time(NULL));  // Initialize random seed
     
     // Initialize timer handle to NULL
     s_animation_timer = NULL;
+    animation_settings_load();
     
     // Create main window
     s_main_window = window_create();
@@ -1520,6 +3648,10 @@ static void init(void) {
         return;
     }
     
+    // No background fill: the canvas clears only what changed and relies on
+    // the previous frame staying in the framebuffer
+    window_set_background_color(s_main_window, GColorClear);
+    
     // Set window handlers
     window_set_window_handlers(s_main_window, (WindowHandlers) {
         .load = main_window_load,
@@ -1532,6 +3664,13 @@ static void init(void) {
     // Register services
     tick_timer_service_subscribe(MINUTE_UNIT, tick_handler);
     battery_state_service_subscribe(battery_callback);  // Use callback function
+    accel_tap_service_subscribe(accel_tap_handler);     // Wake from idle
+    app_focus_service_subscribe(app_focus_handler);
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    unobstructed_area_service_subscribe((UnobstructedAreaHandlers) {
+        .did_change = unobstructed_did_change
+    }, NULL);
+#endif
     
     // Get initial battery state
     s_battery_level = battery_state_service_peek().charge_percent;
@@ -1576,6 +3715,11 @@ static void deinit(void) {
         s_shark_fin_path = NULL;
     }
     
+    if (s_batch_path) {
+        gpath_destroy(s_batch_path);
+        s_batch_path = NULL;
+    }
+    
     if (s_main_window) {
         window_destroy(s_main_window);
         s_main_window = NULL;
@@ -1583,6 +3727,12 @@ static void deinit(void) {
     
     tick_timer_service_unsubscribe();
     battery_state_service_unsubscribe();  // Unsubscribe from battery service
+    accel_tap_service_unsubscribe();
+    app_focus_service_unsubscribe();
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    unobstructed_area_service_unsubscribe();
+#endif
+    animation_settings_save();
 }
 
 int main(void) {